@@ -0,0 +1,73 @@
+/*
+ * bench_hex.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * Times the table driven exonaut_hex_decode() against the per character
+ * hex2int()/HEX_TO_INT decoding it replaced, over the 16 digits of an 'EMM'
+ * frame, and checks that both give the same bytes.
+ */
+
+#include "ExoNaut_Hex.h"
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+
+// The original decoder from ExoNaut.cpp
+static inline uint8_t hex2int(uint8_t ch)
+{
+    if (ch >= '0' && ch <= '9')
+    {
+        return (ch - '0');
+    }
+    if (ch >= 'A' && ch <= 'F')
+    {
+        return (ch - 'A' + 10);
+    }
+    if (ch >= 'a' && ch <= 'f')
+    {
+        return (ch - 'a' + 10);
+    }
+    return (uint8_t)-1;
+}
+#define HEX_TO_INT(high, low) ((uint8_t)((0xF0 & (((hex2int((high))) << 4))) | (0x0F & (hex2int((low))))))
+
+#define ROUNDS 2000000
+
+int main(void)
+{
+    const uint8_t frame[] = "00001A2BFFFFE5D4";
+    uint8_t a[8], b[8];
+    volatile uint32_t sink = 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; r++)
+    {
+        for (int i = 0; i < 8; i++)
+        {
+            a[i] = HEX_TO_INT(frame[2 * i], frame[2 * i + 1]);
+        }
+        sink += a[r & 7];
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; r++)
+    {
+        if (!exonaut_hex_decode(frame, 16, b))
+        {
+            printf("FAIL: valid digits rejected\n");
+            return 1;
+        }
+        sink += b[r & 7];
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    if (memcmp(a, b, 8) != 0)
+    {
+        printf("FAIL: decoders disagree\n");
+        return 1;
+    }
+    double old_ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / ROUNDS;
+    double lut_ns = std::chrono::duration<double, std::nano>(t2 - t1).count() / ROUNDS;
+    printf("hex2int %.1f ns/frame, lut %.1f ns/frame (host, for comparison only)\n", old_ns, lut_ns);
+    return 0;
+}
@@ -0,0 +1,31 @@
+#!/bin/sh
+#
+# Host tests for the parts of the library that have no Arduino dependencies.
+# Each test_*.cpp and bench_*.cpp is built with g++ against the portable
+# sources in src and run; the script stops at the first failure.
+#
+#   sh extras/tests/run_tests.sh
+#
+
+set -e
+HERE=$(cd "$(dirname "$0")" && pwd)
+SRC="$HERE/../../src"
+OUT=${TMPDIR:-/tmp}/exonaut_tests
+mkdir -p "$OUT"
+
+PORTABLE="ExoNaut_AckTracker ExoNaut_Battery ExoNaut_BusServo ExoNaut_Capture ExoNaut_CoProcSim ExoNaut_Commands ExoNaut_Framer ExoNaut_Hex
+          ExoNaut_IREvents ExoNaut_MotorCal ExoNaut_MotorFaults ExoNaut_Odometry ExoNaut_Profile ExoNaut_SegmentFollower
+          ExoNaut_ServoTrajectory ExoNaut_Telemetry"
+SOURCES=""
+for m in $PORTABLE; do
+    SOURCES="$SOURCES $SRC/$m.cpp"
+done
+
+for t in "$HERE"/test_*.cpp "$HERE"/bench_*.cpp; do
+    [ -f "$t" ] || continue
+    name=$(basename "$t" .cpp)
+    echo "== $name"
+    g++ -std=gnu++11 -O2 -Wall -pthread -I"$SRC" "$t" $SOURCES -o "$OUT/$name"
+    "$OUT/$name"
+done
+echo "all passed"
@@ -0,0 +1,160 @@
+/*
+ * test_ack_tracker.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * Runs ExoNaut_AckTracker the way tx_task does, against ExoNaut_CoProcSim.
+ * Checks that speed packets and encoder requests keep flowing during a long
+ * acknowledged servo move without their acks being taken for the move's, that
+ * a lost stop is resent until the co-processor acks it, that a stop overtaken
+ * by a newer speed packet is reported as replaced and not resent, that a
+ * single servo move (as bus_servo_set_pose() sends it in acknowledged mode)
+ * is resent and confirmed when it ends, and that a command on a dead link
+ * times out after its retries.
+ */
+
+#include "ExoNaut_AckTracker.h"
+#include "ExoNaut_BusServo.h"
+#include "ExoNaut_CoProcSim.h"
+#include "ExoNaut_Commands.h"
+#include "ExoNaut_Framer.h"
+#include "ExoNaut_Telemetry.h"
+#include "test_util.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#define TIMEOUT_MS 50 // EXONAUT_ACK_TIMEOUT_MS
+#define RETRIES 2     // EXONAUT_ACK_RETRIES
+
+static ExoNaut_CoProcSim sim;
+static ExoNaut_RingBuffer ring;
+static ExoNaut_Framer framer(ring);
+static ExoNaut_Telemetry telem;
+static ExoNaut_AckTracker tracker;
+static uint32_t now_ms = 0;
+static bool link_up = true;   // false: nothing reaches the co-processor
+static uint32_t resends = 0;
+static uint8_t result[8];     // last ack_event_type_t per id, 0xFF for none
+static uint32_t result_ms[8]; // when it was reported
+
+// tx_task's write: to the UART, then to the tracker
+static void write(const uint8_t *pkt, uint8_t len, uint32_t id, bool lose = false)
+{
+    if (link_up && !lose)
+        sim.feed(pkt, len);
+    tracker.sent(pkt, len, id, now_ms);
+}
+
+static void speed(int8_t b1, int8_t b2, uint32_t id = 0, bool lose = false)
+{
+    uint8_t pkt[EXONAUT_SPEED_PACKET_SIZE];
+    write(pkt, (uint8_t)exonaut_encode_speed(b1, b2, pkt, sizeof(pkt)), id, lose);
+}
+
+// Advance by ms: the co-processor, rx_task's decode and tx_task's ack handling
+static void run(uint32_t ms)
+{
+    for (uint32_t i = 0; i < ms; i++)
+    {
+        now_ms++;
+        sim.step(now_ms * 1000);
+        uint8_t *span;
+        size_t space;
+        while (sim.available() > 0 && (space = ring.writeSpan(&span)) > 0)
+            ring.commit(sim.read(span, space));
+        exonaut_frame_t frame;
+        while (framer.next(&frame))
+        {
+            if (telem.decode(&frame, now_ms * 1000, now_ms, 0) & TELEM_ACK)
+                tracker.acked(now_ms);
+        }
+        ack_event_t ev;
+        while (tracker.poll(now_ms, &ev))
+        {
+            if (ev.type == ACK_EVENT_RESEND)
+            {
+                resends++;
+                if (link_up)
+                    sim.feed(ev.data, ev.len);
+                continue;
+            }
+            result[ev.id] = ev.type;
+            result_ms[ev.id] = now_ms;
+        }
+    }
+}
+
+int main(void)
+{
+    memset(result, 0xFF, sizeof(result));
+    tracker.setTimeout(TIMEOUT_MS, RETRIES);
+    run(20); // start up 'V' frame
+
+    // A 1500 ms servo move, with speed packets and encoder requests every 10 ms meanwhile
+    bus_servo_pose_t pose = {1, 800};
+    uint8_t move[BUS_SERVO_PACKET_SIZE(1)];
+    size_t len = exonaut_servo_encode_move(&pose, 1, 1500, move, sizeof(move));
+    check(exonaut_ack_delay(move, (uint8_t)len) == 1500, "servo move acked after its move time");
+    uint32_t start = now_ms;
+    write(move, (uint8_t)len, 1);
+    uint8_t request[EXONAUT_ENCODER_REQUEST_SIZE];
+    exonaut_encode_encoder_request(request, sizeof(request));
+    check(exonaut_ack_delay(request, sizeof(request)) < 0, "encoder requests are not acked");
+    uint32_t seq = telem.state.encoder.seq;
+    for (int i = 0; i < 140; i++)
+    {
+        speed((int8_t)(i % 20), (int8_t)(i % 20));
+        write(request, sizeof(request), 0);
+        run(10);
+    }
+    check(telem.state.encoder.seq - seq == 140, "every encoder request answered during the move");
+    check(tracker.busy() && result[1] == 0xFF, "move still outstanding after 1400 ms");
+    run(150);
+    check(result[1] == ACK_EVENT_DONE && result_ms[1] - start >= 1500, "move confirmed when it ends");
+    check(resends == 0 && tracker.unmatched == 0 && !tracker.busy(), "no resend, every ack matched");
+
+    // A stop lost on the wire is resent until it is acked
+    speed(-7, -7);
+    run(500);
+    check(fabsf(sim.wheelSpeed(1)) > 0.5f, "wheels running");
+    speed(0, 0, 2, true);
+    run(TIMEOUT_MS + 5);
+    check(resends == 1 && result[2] == ACK_EVENT_DONE, "stop resent and confirmed");
+    run(500);
+    check(fabsf(sim.wheelSpeed(1)) < 0.01f && fabsf(sim.wheelSpeed(2)) < 0.01f, "wheels stopped");
+
+    // A lost stop overtaken by a newer speed packet is not resent over it
+    speed(0, 0, 3, true);
+    run(5);
+    speed(-5, -5);
+    run(TIMEOUT_MS * 4);
+    check(result[3] == ACK_EVENT_REPLACED && resends == 1, "stop replaced, not resent");
+    check(fabsf(sim.wheelSpeed(1)) > 0.5f, "wheels follow the newer packet");
+
+    // bus_servo_set_pose() in acknowledged mode: one servo, tracked; lost once, resent,
+    // and confirmed only when the resent move ends
+    pose.pos = 200;
+    len = exonaut_servo_encode_move(&pose, 1, 400, move, sizeof(move));
+    check(len == 10 && move[2] == 0x08 && move[4] == 1, "single servo packet");
+    start = now_ms;
+    write(move, (uint8_t)len, 5, true);
+    run(400 + TIMEOUT_MS);
+    check(resends == 2 && result[5] == 0xFF && tracker.busy(), "single servo move resent after its move time and the timeout");
+    run(399);
+    check(result[5] == 0xFF, "no ack before the resent move ends");
+    run(2);
+    check(result[5] == ACK_EVENT_DONE && result_ms[5] - start == 2 * 400 + TIMEOUT_MS, "single servo move confirmed");
+
+    // Nothing gets through: the command is resent RETRIES times, then times out
+    link_up = false;
+    uint8_t type[EXONAUT_SETTING_PACKET_SIZE];
+    start = now_ms;
+    write(type, (uint8_t)exonaut_encode_motor_type(1, type, sizeof(type)), 4);
+    run(TIMEOUT_MS * (RETRIES + 1) + 5);
+    check(resends == 2 + RETRIES, "resent on a dead link");
+    check(result[4] == ACK_EVENT_TIMEOUT && result_ms[4] - start == TIMEOUT_MS * (RETRIES + 1), "timed out after every retry");
+    check(!tracker.busy() && tracker.nextDeadline(now_ms) < 0, "nothing left outstanding");
+
+    return test_result();
+}
@@ -0,0 +1,85 @@
+/*
+ * test_battery.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * Runs ExoNaut_Battery through a long idle period (hours of readings at the
+ * 50 ms telemetry rate, no load change at all) and then a series of load
+ * steps, and checks the sag fit stays finite and recovers the true model,
+ * and that the speed limit never exceeds the BATTERY_FULL_LOAD ceiling.
+ * Also checks that two readings in the same millisecond keep the voltage
+ * finite, with and without the filter.
+ */
+
+#include "ExoNaut_Battery.h"
+#include "test_util.h"
+#include <math.h>
+#include <stdio.h>
+
+#define OPEN_MV 7400.0f
+#define SAG 4.0f // mV per unit of speed
+
+int main(void)
+{
+    ExoNaut_Battery b;
+    uint32_t t = 0;
+    check(b.status().speed_limit == BATTERY_FULL_LOAD, "speed limit before the first reading");
+
+    // Three hours idle, far past the point where the old update overflowed
+    for (int i = 0; i < 216000; i++, t += 50)
+    {
+        b.update(OPEN_MV, 0, t);
+    }
+    const battery_status_t &st = b.status();
+    check(isfinite(st.open_circuit) && isfinite(st.sag_per_speed), "fit finite after idle");
+    check(fabsf(st.open_circuit - OPEN_MV) < 5, "open circuit voltage after idle");
+    check(st.speed_limit == BATTERY_FULL_LOAD, "same speed limit ceiling with no sag measured");
+
+    // Cruise at a constant load for a long time too
+    for (int i = 0; i < 100000; i++, t += 50)
+    {
+        b.update(OPEN_MV - SAG * 60, 60, t);
+    }
+    check(isfinite(st.open_circuit) && isfinite(st.sag_per_speed), "fit finite after cruising");
+
+    // Load steps between 0, 40 and 80
+    const float loads[] = {0, 40, 80, 40};
+    for (int i = 0; i < 2000; i++, t += 50)
+    {
+        float load = loads[(i / 25) % 4];
+        b.update(OPEN_MV - SAG * load, load, t);
+    }
+    printf("open %.1f mV, sag %.3f mV/speed, limit %.1f\n", st.open_circuit, st.sag_per_speed, st.speed_limit);
+    check(fabsf(st.open_circuit - OPEN_MV) < 10, "open circuit voltage after load steps");
+    check(fabsf(st.sag_per_speed - SAG) < 0.2f, "sag after load steps");
+    check(st.speed_limit == BATTERY_FULL_LOAD, "a pack that holds up at full load is not limited past the ceiling");
+
+    // A weak pack: the limit is the load that sags to the critical level
+    ExoNaut_Battery weak;
+    const float weak_mv = BATTERY_CRITICAL_MV + SAG * 50;
+    for (int i = 0; i < 2000; i++, t += 50)
+    {
+        float load = loads[(i / 25) % 4];
+        weak.update(weak_mv - SAG * load, load, t);
+    }
+    printf("weak pack limit %.1f\n", weak.status().speed_limit);
+    check(fabsf(weak.status().speed_limit - 50) < 3, "speed limit of a weak pack");
+
+    // Two frames decoded in the same millisecond, with no filter: each reading is taken as it is
+    ExoNaut_Battery raw;
+    raw.setFilter(0);
+    raw.update(OPEN_MV, 0, 1000);
+    raw.update(OPEN_MV - 200, 0, 1000);
+    check(raw.status().volt == OPEN_MV - 200, "unfiltered reading in the same millisecond");
+    raw.update(OPEN_MV - 100, 0, 1050);
+    check(raw.status().volt == OPEN_MV - 100 && raw.status().level == BATTERY_OK, "unfiltered reading after it");
+
+    // The same with the filter: the second reading moves nothing
+    ExoNaut_Battery same;
+    same.update(OPEN_MV, 0, 1000);
+    same.update(OPEN_MV - 200, 0, 1000);
+    check(same.status().volt == OPEN_MV, "filtered reading in the same millisecond");
+    same.update(OPEN_MV - 200, 0, 1050);
+    check(isfinite(same.status().volt) && same.status().volt < OPEN_MV, "filtered reading after it");
+    return test_result();
+}
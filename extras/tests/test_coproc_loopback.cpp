@@ -0,0 +1,203 @@
+/*
+ * test_coproc_loopback.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * Drives the library's protocol code against ExoNaut_CoProcSim.  Every packet
+ * is built by the encoders the exonaut class uses (ExoNaut_Commands.h, the
+ * speed bytes of ExoNaut_MotorCal.h and the bus servo batch encoder) and goes
+ * out through ExoNaut_AckTracker as tx_task sends it; everything the simulator
+ * sends back goes through ExoNaut_Framer and ExoNaut_Telemetry as in rx_task.
+ * Checks the packet bytes, the start up version, that set_motor_speed() bytes
+ * give the documented wheel speed with counts rising for positive speeds, the
+ * encoder stream rate and latency, that the motor type and speed packets are
+ * confirmed at once, the switch to binary telemetry, and that a batch servo
+ * move is only confirmed once its move time has passed, with every servo where
+ * it was sent.
+ */
+
+#include "ExoNaut_AckTracker.h"
+#include "ExoNaut_BusServo.h"
+#include "ExoNaut_CoProcSim.h"
+#include "ExoNaut_Commands.h"
+#include "ExoNaut_Framer.h"
+#include "ExoNaut_MotorCal.h"
+#include "ExoNaut_Telemetry.h"
+#include "test_util.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#define RPM_PER_SPEED (90.0f / 55.0f) // EXONAUT_RPM_PER_SPEED
+#define PULSES 1120                   // PULSE_COUNT, motor type 1
+#define TIMEOUT_MS 50                 // EXONAUT_ACK_TIMEOUT_MS
+#define RETRIES 2                     // EXONAUT_ACK_RETRIES
+
+static ExoNaut_CoProcSim sim;
+static ExoNaut_RingBuffer ring;
+static ExoNaut_Framer framer(ring);
+static ExoNaut_Telemetry telem;
+static ExoNaut_AckTracker tracker;
+static uint32_t now_us = 0;
+static uint32_t binary_frames = 0;
+static uint32_t resends = 0;
+static uint8_t result[8];     // last ack_event_type_t per command id, 0xFF for none
+static uint32_t result_ms[8]; // when it was reported
+
+static uint32_t now_ms(void)
+{
+    return now_us / 1000;
+}
+
+// tx_task's write: to the UART, then to the tracker; id 0 is untracked
+static void send(const uint8_t *pkt, size_t len, uint32_t id = 0)
+{
+    check(len > 0, "packet encoded");
+    sim.feed(pkt, len);
+    tracker.sent(pkt, (uint8_t)len, id, now_ms());
+}
+
+// set_motor_speed() with no calibration loaded
+static void set_speed(float speed_1, float speed_2, uint32_t id = 0)
+{
+    uint8_t pkt[EXONAUT_SPEED_PACKET_SIZE];
+    send(pkt, exonaut_encode_speed(exonaut_speed_byte(NULL, 0, speed_1), exonaut_speed_byte(NULL, 1, speed_2), pkt, sizeof(pkt)), id);
+}
+
+// Advance the link by ms: the co-processor, rx_task's decode and tx_task's ack handling
+static void run(uint32_t ms)
+{
+    for (uint32_t i = 0; i < ms; i++)
+    {
+        now_us += 1000;
+        sim.step(now_us);
+        uint8_t *span;
+        size_t space;
+        while (sim.available() > 0 && (space = ring.writeSpan(&span)) > 0)
+        {
+            ring.commit(sim.read(span, space));
+        }
+        exonaut_frame_t frame;
+        while (framer.next(&frame))
+        {
+            if (frame.format == EXONAUT_FRAME_BINARY)
+                binary_frames++;
+            if (telem.decode(&frame, now_us, now_ms(), 0) & TELEM_ACK)
+                tracker.acked(now_ms());
+        }
+        ack_event_t ev;
+        while (tracker.poll(now_ms(), &ev))
+        {
+            if (ev.type == ACK_EVENT_RESEND)
+            {
+                resends++;
+                sim.feed(ev.data, ev.len);
+                continue;
+            }
+            result[ev.id] = ev.type;
+            result_ms[ev.id] = now_ms();
+        }
+    }
+}
+
+static bool encodes(size_t len, const uint8_t *pkt, const uint8_t *want, size_t want_len)
+{
+    return len == want_len && memcmp(pkt, want, want_len) == 0;
+}
+
+int main(void)
+{
+    // The builders write the packets the exonaut class used to spell out
+    uint8_t out[EXONAUT_SPEED_PACKET_SIZE];
+    const uint8_t speed_50[] = {0x55, 0x55, 0x05, 55, 0x02, 0xF7, 0x09}; // set_motor_speed(50, -50)
+    const uint8_t type_2[] = {0x55, 0x55, 0x04, 55, 0x01, 0x02};
+    const uint8_t request[] = {0x55, 0x55, 0x03, 55, 0x03};
+    const uint8_t binary[] = {0x55, 0x55, 0x04, 55, 0x10, 0x01};
+    const uint8_t stream_100[] = {0x55, 0x55, 0x04, 55, 0x11, 100};
+    check(encodes(exonaut_encode_speed(exonaut_speed_byte(NULL, 0, 50), exonaut_speed_byte(NULL, 1, -50), out, sizeof(out)), out, speed_50,
+                  sizeof(speed_50)) &&
+              encodes(exonaut_encode_motor_type(2, out, sizeof(out)), out, type_2, sizeof(type_2)) &&
+              encodes(exonaut_encode_encoder_request(out, sizeof(out)), out, request, sizeof(request)) &&
+              encodes(exonaut_encode_telemetry_format(true, out, sizeof(out)), out, binary, sizeof(binary)) &&
+              encodes(exonaut_encode_stream_rate(100, out, sizeof(out)), out, stream_100, sizeof(stream_100)),
+          "packet bytes");
+    check(exonaut_encode_speed(1, 1, out, EXONAUT_SPEED_PACKET_SIZE - 1) == 0, "a packet that does not fit is not written");
+
+    memset(result, 0xFF, sizeof(result));
+    tracker.setTimeout(TIMEOUT_MS, RETRIES);
+    run(20);
+    check(telem.version[0] == 'V', "version frame at start up");
+
+    // set_motor_type(1), tracked
+    uint8_t pkt[BUS_SERVO_PACKET_SIZE(BUS_SERVO_MAX_BATCH)];
+    send(pkt, exonaut_encode_motor_type(1, pkt, sizeof(pkt)), 1);
+    run(10);
+    check(result[1] == ACK_EVENT_DONE, "motor type confirmed");
+
+    // Stream the encoders at 50 Hz, then set_motor_speed(40, -20), tracked
+    send(pkt, exonaut_encode_stream_rate(50, pkt, sizeof(pkt)));
+    run(35);
+    set_speed(40, -20, 2);
+    run(1000); // let the wheels settle
+    check(result[2] == ACK_EVENT_DONE && result_ms[2] - sim.last_speed_us / 1000 <= 2, "the speed packet is confirmed at once");
+    check(tracker.unmatched == 0 && !tracker.busy(), "the stream rate is not acknowledged");
+    check(sim.first_encoder_us - sim.last_speed_us <= 20000, "counts within one stream period of the speed packet");
+    encoder_snapshot_t a = telem.state.encoder;
+    run(1000);
+    encoder_snapshot_t b = telem.state.encoder;
+    check(b.seq - a.seq == 50, "50 Hz encoder stream, no period lost");
+    check(b.timestamp_us - a.timestamp_us == 1000000, "stream period");
+    // The byte is quantised and a loaded pack cannot reach the full speed, see ExoNaut_CoProcSim::physics()
+    float headroom = sim.voltage() / COPROC_SIM_OPEN_MV;
+    float want_1 = -exonaut_speed_byte(NULL, 0, 40) * (100.0f / 680.0f) * 60.0f * headroom;
+    float want_2 = -exonaut_speed_byte(NULL, 1, -20) * (100.0f / 680.0f) * 60.0f * headroom;
+    float dt_min = (b.timestamp_us - a.timestamp_us) / 60.0e6f;
+    float rpm_1 = (b.count_1 - a.count_1) / (float)PULSES / dt_min;
+    float rpm_2 = (b.count_2 - a.count_2) / (float)PULSES / dt_min;
+    printf("wheel 1 %.2f rpm (want %.2f), wheel 2 %.2f rpm (want %.2f)\n", rpm_1, want_1, rpm_2, want_2);
+    check(rpm_1 > 0 && fabsf(rpm_1 - want_1) < 0.01f * want_1, "wheel 1 speed and direction");
+    check(rpm_2 < 0 && fabsf(rpm_2 - want_2) < 0.01f * -want_2, "wheel 2 speed and direction");
+    check(fabsf(rpm_1 - 40 * RPM_PER_SPEED) < 0.1f * 40 * RPM_PER_SPEED, "wheel 1 near the documented speed");
+    check(fabsf(rpm_2 + 20 * RPM_PER_SPEED) < 0.15f * 20 * RPM_PER_SPEED, "wheel 2 near the documented speed");
+
+    // Binary telemetry, confirmed by a binary 'V' frame
+    send(pkt, exonaut_encode_telemetry_format(true, pkt, sizeof(pkt)));
+    run(100);
+    check(binary_frames > 0 && sim.binary(), "binary telemetry");
+    uint32_t seq = telem.state.encoder.seq;
+    run(100);
+    check(telem.state.encoder.seq > seq && telem.state.encoder.dropped == 0, "binary encoder frames");
+
+    // A tracked stop, as stop_motor() sends it in acknowledged mode
+    set_speed(0, 0, 3);
+    run(500);
+    check(result[3] == ACK_EVENT_DONE && fabsf(sim.wheelSpeed(1)) < 0.01f && fabsf(sim.wheelSpeed(2)) < 0.01f, "stop confirmed, wheels stopped");
+
+    // A 300 ms move of four servos in one batch, confirmed when it ends and not before
+    bus_servo_pose_t poses[4] = {{1, 250}, {2, 750}, {3, 0}, {4, BUS_SERVO_POS_MAX}};
+    send(pkt, exonaut_servo_encode_move(poses, 4, 300, pkt, sizeof(pkt)), 4);
+    uint32_t start = now_ms();
+    // Encoder requests keep going out untracked meanwhile, as from the encoder timer
+    for (int i = 0; i < 29; i++)
+    {
+        send(pkt, exonaut_encode_encoder_request(pkt, sizeof(pkt)));
+        run(10);
+    }
+    check(result[4] == 0xFF && tracker.busy(), "no confirmation before the move ends");
+    run(20);
+    check(result[4] == ACK_EVENT_DONE && result_ms[4] - start >= 300 && result_ms[4] - start <= 302, "move confirmed when it ends");
+
+    // Every servo of the batch is where it was sent
+    bool placed = true;
+    for (int i = 0; i < 4; i++)
+    {
+        send(pkt, exonaut_servo_encode_read(poses[i].id, pkt, sizeof(pkt)));
+        run(10);
+        placed = placed && telem.servo.id == poses[i].id && telem.servo.pos == poses[i].pos;
+    }
+    check(placed, "servo readback after the batch move");
+
+    check(resends == 0 && tracker.unmatched == 0 && !tracker.busy(), "no resend, every ack matched");
+    check(sim.bad_packets == 0, "every packet understood");
+    return test_result();
+}
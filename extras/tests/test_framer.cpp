@@ -0,0 +1,251 @@
+/*
+ * test_framer.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * Feeds ExoNaut_Framer one long byte stream of ASCII and binary frames in
+ * reads of every size from 1 to 40 bytes and of random sizes, and checks each
+ * emitted frame against what was sent.  The stream runs several times round
+ * the 256 byte ring, so frames of both formats straddle its end and come back
+ * through the scratch copy.  Oversize ASCII frames and a binary frame with a
+ * bad CRC must be dropped without losing the frames after them.  Also checks
+ * a binary frame split across reads byte by byte, and that reset() after the
+ * ring has overflowed starts cleanly on the next frame.
+ */
+
+#include "ExoNaut_Framer.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <string.h>
+
+#define STREAM_MAX 4096
+#define FRAMES_MAX 256
+
+typedef struct
+{
+    size_t at;    // stream offset of the first body byte
+    uint8_t format;
+    uint8_t len;
+    uint8_t data[EXONAUT_FRAME_MAX];
+} expect_t;
+
+static uint8_t stream[STREAM_MAX];
+static size_t stream_len = 0;
+static expect_t expected[FRAMES_MAX];
+static int expected_count = 0;
+
+static void add_bytes(const uint8_t *data, size_t len)
+{
+    memcpy(stream + stream_len, data, len);
+    stream_len += len;
+}
+
+static void expect(size_t at, uint8_t format, const uint8_t *data, uint8_t len)
+{
+    expect_t *e = &expected[expected_count++];
+    e->at = at;
+    e->format = format;
+    e->len = len;
+    memcpy(e->data, data, len);
+}
+
+// text followed by '$', a frame unless it is too long
+static void add_ascii(const char *text, const char *after = "")
+{
+    size_t len = strlen(text);
+    if (len <= EXONAUT_FRAME_MAX)
+        expect(stream_len, EXONAUT_FRAME_ASCII, (const uint8_t *)text, (uint8_t)len);
+    add_bytes((const uint8_t *)text, len);
+    add_bytes((const uint8_t *)"$", 1);
+    add_bytes((const uint8_t *)after, strlen(after));
+}
+
+static size_t build_binary(uint8_t *f, uint8_t type, const uint8_t *payload, uint8_t len)
+{
+    f[0] = EXONAUT_BIN_SYNC;
+    f[1] = len;
+    f[2] = type;
+    memcpy(f + 3, payload, len);
+    f[3 + len] = exonaut_crc8(f + 1, len + 2);
+    return len + EXONAUT_BIN_OVERHEAD;
+}
+
+static void add_binary(uint8_t type, const uint8_t *payload, uint8_t len, bool corrupt = false)
+{
+    uint8_t f[EXONAUT_BIN_PAYLOAD_MAX + EXONAUT_BIN_OVERHEAD];
+    size_t n = build_binary(f, type, payload, len);
+    if (corrupt)
+        f[3] ^= 0x01;
+    else
+        expect(stream_len + 2, EXONAUT_FRAME_BINARY, f + 2, len + 1); // the body starts at TYPE
+    add_bytes(f, n);
+}
+
+// Does the frame body cross the end of the ring, given the ring started at 0?
+static bool wraps(const expect_t *e)
+{
+    // A binary frame is linearised from LEN onwards
+    size_t first = e->format == EXONAUT_FRAME_BINARY ? e->at - 1 : e->at;
+    size_t last = e->at + e->len - 1;
+    return e->len > 0 && first / EXONAUT_RX_RING_SIZE != last / EXONAUT_RX_RING_SIZE;
+}
+
+static bool same(const exonaut_frame_t *f, const expect_t *e)
+{
+    return f->format == e->format && f->len == e->len && memcmp(f->data, e->data, e->len) == 0;
+}
+
+typedef struct
+{
+    int frames;
+    int wrong;    // frames that differ from what was sent, or too many
+    bool overflow; // a read did not fit in the ring
+    uint32_t dropped;
+    uint32_t crc_errors;
+} fed_t;
+
+static uint32_t lcg = 12345;
+
+static size_t random_chunk(void)
+{
+    lcg = lcg * 1103515245u + 12345u;
+    return 1 + (lcg >> 16) % 40;
+}
+
+// The whole stream in reads of chunk bytes (0 for random sizes), taking every frame after each read
+static fed_t feed(size_t chunk)
+{
+    ExoNaut_RingBuffer ring;
+    ExoNaut_Framer framer(ring);
+    fed_t fed = {0, 0, false, 0, 0};
+    for (size_t pos = 0; pos < stream_len;)
+    {
+        size_t n = chunk != 0 ? chunk : random_chunk();
+        if (n > stream_len - pos)
+            n = stream_len - pos;
+        if (ring.write(stream + pos, n) != n)
+            fed.overflow = true;
+        pos += n;
+        exonaut_frame_t frame;
+        while (framer.next(&frame))
+        {
+            if (fed.frames >= expected_count || !same(&frame, &expected[fed.frames]))
+                fed.wrong++;
+            fed.frames++;
+        }
+    }
+    fed.dropped = framer.dropped;
+    fed.crc_errors = framer.crc_errors;
+    return fed;
+}
+
+int main(void)
+{
+    // The stream: telemetry-like ASCII and binary frames of varied lengths
+    const uint8_t counts[] = {0x10, 0x20, 0x30, 0x40, 0x50, 0x60, 0x70, 0x01, 0x02, 0x03, 0x04, 0x05};
+    char text[EXONAUT_FRAME_MAX + 40];
+    for (int i = 0; i < 48; i++)
+    {
+        size_t len = 3 + (i * 7) % 40;
+        for (size_t k = 0; k < len; k++)
+            text[k] = "0123456789ABCDEF"[(i + k) % 16];
+        text[0] = "AEV"[i % 3];
+        text[len] = '\0';
+        add_ascii(text, i % 4 == 0 ? "\r\n" : "");
+        add_binary('E', counts, (uint8_t)(1 + i % 12));
+    }
+    // The longest accepted ASCII frame, then two too long; the frames after them come through
+    memset(text, 'x', EXONAUT_FRAME_MAX);
+    text[EXONAUT_FRAME_MAX] = '\0';
+    add_ascii(text);
+    memset(text, 'y', EXONAUT_FRAME_MAX + 1);
+    text[EXONAUT_FRAME_MAX + 1] = '\0';
+    add_ascii(text);
+    add_ascii("A1");
+    memset(text, 'z', EXONAUT_FRAME_MAX + 37);
+    text[EXONAUT_FRAME_MAX + 37] = '\0';
+    add_ascii(text);
+    add_ascii("B2");
+    // A bad CRC: the framer drops the sync byte and skips the rest as debris up to the next sync
+    add_binary('E', counts, 8, true);
+    add_binary('E', counts, 12);
+    add_ascii("C3");
+    // Binary frames of the longest payload, and an empty one
+    uint8_t full[EXONAUT_BIN_PAYLOAD_MAX];
+    for (int i = 0; i < EXONAUT_BIN_PAYLOAD_MAX; i++)
+        full[i] = (uint8_t)(i * 37);
+    for (int i = 0; i < 6; i++)
+    {
+        add_binary('S', full, EXONAUT_BIN_PAYLOAD_MAX);
+        add_binary('V', full, 0);
+        add_ascii("I0C45", "\n");
+    }
+
+    int wrapped_ascii = 0, wrapped_binary = 0;
+    for (int i = 0; i < expected_count; i++)
+    {
+        if (wraps(&expected[i]))
+            (expected[i].format == EXONAUT_FRAME_BINARY ? wrapped_binary : wrapped_ascii)++;
+    }
+    printf("%u bytes, %d frames, %d ASCII and %d binary wrap the ring\n", (unsigned)stream_len, expected_count, wrapped_ascii,
+           wrapped_binary);
+    check(wrapped_ascii > 0 && wrapped_binary > 0, "the stream wraps frames of both formats");
+
+    // Every read size from one byte up, then random sizes
+    bool all_ok = true;
+    for (size_t chunk = 0; chunk <= 40; chunk++)
+    {
+        for (int pass = 0; pass < (chunk == 0 ? 20 : 1); pass++)
+        {
+            fed_t fed = feed(chunk);
+            bool ok = !fed.overflow && fed.frames == expected_count && fed.wrong == 0 && fed.dropped == 3 && fed.crc_errors == 1;
+            if (!ok)
+            {
+                printf("reads of %u: %d frames of %d, %d wrong, dropped %u, crc errors %u%s\n", (unsigned)chunk, fed.frames, expected_count,
+                       fed.wrong, (unsigned)fed.dropped, (unsigned)fed.crc_errors, fed.overflow ? ", overflow" : "");
+                all_ok = false;
+            }
+        }
+    }
+    check(all_ok, "every frame, whatever the read size");
+
+    // A binary frame arriving a byte at a time is only returned once complete
+    {
+        ExoNaut_RingBuffer ring;
+        ExoNaut_Framer framer(ring);
+        uint8_t f[EXONAUT_BIN_PAYLOAD_MAX + EXONAUT_BIN_OVERHEAD];
+        size_t n = build_binary(f, 'E', counts, 12);
+        exonaut_frame_t frame;
+        bool early = false;
+        for (size_t i = 0; i + 1 < n; i++)
+        {
+            ring.write(f + i, 1);
+            early |= framer.next(&frame);
+        }
+        ring.write(f + n - 1, 1);
+        bool got = framer.next(&frame);
+        check(!early && got && frame.format == EXONAUT_FRAME_BINARY && frame.len == 13 && frame.data[0] == 'E' &&
+                  memcmp(frame.data + 1, counts, 12) == 0 && framer.crc_errors == 0,
+              "binary frame split across reads");
+    }
+
+    // Overflow: the link runs on with nobody reading, then reset() drops the lot
+    {
+        ExoNaut_RingBuffer ring;
+        ExoNaut_Framer framer(ring);
+        size_t written = ring.write(stream, 300);
+        check(written == EXONAUT_RX_RING_SIZE && ring.available() == EXONAUT_RX_RING_SIZE, "overflow fills the ring and drops the rest");
+        framer.reset();
+        check(ring.available() == 0, "reset empties the ring");
+        uint8_t f[EXONAUT_BIN_PAYLOAD_MAX + EXONAUT_BIN_OVERHEAD];
+        size_t n = build_binary(f, 'E', counts, 8);
+        ring.write((const uint8_t *)"A7F$", 4);
+        ring.write(f, n);
+        exonaut_frame_t frame;
+        bool ascii = framer.next(&frame) && frame.format == EXONAUT_FRAME_ASCII && frame.len == 3 && memcmp(frame.data, "A7F", 3) == 0;
+        bool binary = framer.next(&frame) && frame.format == EXONAUT_FRAME_BINARY && frame.len == 9 && memcmp(frame.data + 1, counts, 8) == 0;
+        check(ascii && binary && !framer.next(&frame) && framer.dropped == 0, "clean start after reset");
+    }
+
+    return test_result();
+}
@@ -0,0 +1,188 @@
+/*
+ * test_motor_faults.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * Drives ExoNaut_MotorFaults with 50 Hz encoder frames from two simulated
+ * wheels.  Checks that wheels tracking their command raise nothing, that a
+ * stall, a lifted wheel and slip are each classified and reported only once
+ * they have lasted the hold time, that a new command gets the settle time and
+ * slow commands are not judged, that a wheel recovers as soon as the condition
+ * ends, that a missing frame restarts the speed measurement, and that a
+ * latched wheel keeps its fault until clear() and is then judged afresh.
+ */
+
+#include "ExoNaut_MotorFaults.h"
+#include "test_util.h"
+#include <math.h>
+#include <stdio.h>
+
+#define PULSES 1120.0f // PULSE_COUNT
+#define FRAME_US 20000
+
+static ExoNaut_MotorFaults faults;
+static encoder_snapshot_t snap = {0, 0, 0, 0, 0};
+static float pos[2] = {0, 0}; // pulses, kept fractional
+static float command[2] = {0, 0};
+static float actual[2] = {0, 0}; // wheel rpm
+static uint8_t changes[2];        // fault changes reported per wheel
+static uint32_t changed_us[2];    // when the latest was reported
+
+static uint32_t now_ms(void)
+{
+    return snap.timestamp_us / 1000;
+}
+
+// ms of frames with the wheels at actual[]
+static void run(uint32_t ms)
+{
+    for (uint32_t t = 0; t < ms; t += FRAME_US / 1000)
+    {
+        for (int i = 0; i < 2; i++)
+            pos[i] += actual[i] / 60.0f * PULSES * FRAME_US / 1e6f;
+        snap.count_1 = (int32_t)lroundf(pos[0]);
+        snap.count_2 = (int32_t)lroundf(pos[1]);
+        snap.timestamp_us += FRAME_US;
+        snap.seq++;
+        uint8_t changed = faults.update(&snap, PULSES, command);
+        for (int i = 0; i < 2; i++)
+        {
+            if (changed & (1 << i))
+            {
+                changes[i]++;
+                changed_us[i] = snap.timestamp_us;
+            }
+        }
+    }
+}
+
+static void drive(float rpm_0, float rpm_1)
+{
+    command[0] = actual[0] = rpm_0;
+    command[1] = actual[1] = rpm_1;
+}
+
+static void reset_changes(void)
+{
+    changes[0] = changes[1] = 0;
+}
+
+int main(void)
+{
+    // Tracking the command: nothing to report
+    drive(60, 60);
+    run(2000);
+    check(faults.fault(0) == MOTOR_OK && faults.fault(1) == MOTOR_OK && changes[0] == 0 && changes[1] == 0, "tracking wheels are fine");
+    check(fabsf(faults.measured(0) - 60) < 1.0f && faults.command(1) == 60, "measured and commanded speed");
+
+    // Wheel 0 jams: a stall, reported after the hold time
+    actual[0] = 0;
+    uint32_t jam_ms = now_ms();
+    run(MONITOR_HOLD_MS - 40);
+    check(faults.fault(0) == MOTOR_OK, "no stall before the hold time");
+    run(200);
+    check(faults.fault(0) == MOTOR_STALL && faults.fault(1) == MOTOR_OK && changes[0] == 1 && changes[1] == 0, "stall");
+    // The filter takes a few frames to fall under the stall ratio, then the hold starts
+    printf("stall reported %u ms after the jam\n", (unsigned)(changed_us[0] / 1000 - jam_ms));
+    check(changed_us[0] / 1000 - jam_ms >= MONITOR_HOLD_MS && changed_us[0] / 1000 - jam_ms <= MONITOR_HOLD_MS + 100, "stall reported after the hold");
+
+    // It frees itself: back to MOTOR_OK on the next frames, without a hold
+    actual[0] = 60;
+    run(100);
+    check(faults.fault(0) == MOTOR_OK && changes[0] == 2, "recovered without waiting");
+
+    // A jam shorter than the hold is never reported
+    reset_changes();
+    actual[0] = 0;
+    run(200);
+    actual[0] = 60;
+    run(1000);
+    check(changes[0] == 0, "a short jam is ignored");
+
+    // Picked up: the unloaded wheel 1 runs 50% over its command
+    actual[1] = 90;
+    run(MONITOR_HOLD_MS + 200);
+    check(faults.fault(1) == MOTOR_LIFT && faults.fault(0) == MOTOR_OK && changes[1] == 1, "lift");
+    actual[1] = 60;
+    run(200);
+    check(faults.fault(1) == MOTOR_OK, "set down again");
+
+    // Slip: each wheel within its own limits, but 40% apart; the faster one is flagged
+    reset_changes();
+    actual[0] = 72;
+    actual[1] = 48;
+    run(MONITOR_HOLD_MS + 200);
+    check(faults.fault(0) == MOTOR_SLIP && faults.fault(1) == MOTOR_OK && changes[1] == 0, "slip flags the faster wheel");
+    // A turn with both wheels following their different commands is not slip
+    drive(80, 20);
+    run(1500);
+    check(faults.fault(0) == MOTOR_OK && faults.fault(1) == MOTOR_OK, "turning is not slip");
+    // The same reversed, with wheel 1 the faster relative to its command
+    actual[0] = 60;
+    actual[1] = 25;
+    run(MONITOR_HOLD_MS + 300);
+    check(faults.fault(1) == MOTOR_SLIP && faults.fault(0) == MOTOR_OK, "slip on the other wheel");
+
+    // A new command gets the settle time: the wheels lag for 250 ms, nothing is judged
+    drive(60, 60);
+    run(200);
+    reset_changes();
+    command[0] = command[1] = -60;
+    actual[0] = actual[1] = 0;
+    run(MONITOR_SETTLE_MS - 50);
+    actual[0] = actual[1] = -60;
+    run(1500);
+    check(changes[0] == 0 && changes[1] == 0, "the settle time after a new command");
+
+    // Turning the wrong way counts as a stall
+    actual[1] = 60;
+    run(MONITOR_HOLD_MS + 300);
+    check(faults.fault(1) == MOTOR_STALL, "wrong way is a stall");
+    drive(60, 60);
+    run(200);
+
+    // Commands under the minimum are not judged
+    reset_changes();
+    command[0] = command[1] = MONITOR_MIN_RPM / 2;
+    actual[0] = actual[1] = 0;
+    run(2000);
+    check(changes[0] == 0 && changes[1] == 0, "slow commands are not judged");
+
+    // A dropped frame only restarts the speed measurement
+    drive(60, 60);
+    run(500);
+    snap.seq++; // a frame went missing
+    reset_changes();
+    run(500);
+    check(changes[0] == 0 && changes[1] == 0 && fabsf(faults.measured(0) - 60) < 1.0f, "missing frame");
+
+    // Latched: the stall is held while the wheel is still jammed, even once it
+    // frees, until clear(); then the wheel is judged afresh
+    actual[0] = 0;
+    run(MONITOR_HOLD_MS + 200);
+    check(faults.fault(0) == MOTOR_STALL && changes[0] == 1, "stall to latch");
+    faults.latch(0);
+    actual[0] = 60;
+    run(1000);
+    check(faults.fault(0) == MOTOR_STALL && faults.latched(0) && changes[0] == 1, "latched stall kept");
+    actual[0] = 0;
+    faults.clear(0);
+    run(20);
+    check(!faults.latched(0) && faults.fault(0) == MOTOR_OK && changes[0] == 2, "cleared to MOTOR_OK");
+    run(MONITOR_HOLD_MS - 100);
+    check(faults.fault(0) == MOTOR_OK, "judged afresh, hold starts over");
+    run(300);
+    check(faults.fault(0) == MOTOR_STALL && changes[0] == 3, "still jammed: stalls again");
+
+    // Thresholds: a stricter stall ratio catches a wheel at half speed
+    faults.latch(0);
+    faults.clear(0);
+    actual[0] = 30;
+    run(1000);
+    check(faults.fault(0) == MOTOR_OK, "half speed is not a stall by default");
+    faults.setThresholds(0.6f, MONITOR_SLIP_RATIO, MONITOR_LIFT_RATIO);
+    run(1000);
+    check(faults.fault(0) == MOTOR_STALL, "half speed under a stricter stall ratio");
+
+    return test_result();
+}
@@ -0,0 +1,154 @@
+/*
+ * test_motorcal.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * Fits a calibration sweep recorded from two simulated wheels, one weaker and
+ * with a wider deadband than the other.  Checks the least squares gain and
+ * offset and the deadband for each wheel and direction, that the bytes it
+ * gives turn both wheels at the requested speed, that a request below the
+ * deadband jumps over it or stops, and that a wheel that does not turn fails
+ * the fit.  Also checks exonaut_speed_byte_default() against the mapping
+ * encoder_motor_set_speed_base() always used, byte for byte.
+ */
+
+#include "ExoNaut_MotorCal.h"
+#include "test_util.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// A wheel: |rpm| = gain * |byte| + offset from its deadband up, still below it
+typedef struct
+{
+    float gain;
+    float offset;
+    uint8_t deadband;
+} wheel_t;
+
+static const wheel_t wheels[2][2] = {
+    {{6.0f, -4.0f, 2}, {5.8f, -3.0f, 2}},  // wheel 0: forwards, backwards
+    {{5.2f, -6.0f, 3}, {5.0f, -5.0f, 3}},  // wheel 1: weaker and stiffer
+};
+
+static float wheel_rpm(uint8_t w, int8_t byte)
+{
+    uint8_t d = byte < 0 ? 0 : 1;
+    uint8_t mag = (uint8_t)(byte < 0 ? -byte : byte);
+    const wheel_t *m = &wheels[w][d];
+    if (mag < m->deadband)
+        return 0;
+    float rpm = m->gain * mag + m->offset;
+    return d == 0 ? rpm : -rpm;
+}
+
+// The sweep: every byte up to MOTOR_CAL_SWEEP_MAX each way, +-0.3 rpm of encoder noise
+static void sweep(ExoNaut_MotorCal *cal, bool turn_wheel_1 = true)
+{
+    for (uint8_t w = 0; w < 2; w++)
+    {
+        for (int b = 1; b <= MOTOR_CAL_SWEEP_MAX; b++)
+        {
+            float noise = (b % 3 - 1) * 0.3f;
+            float fwd = w == 1 && !turn_wheel_1 ? 0 : wheel_rpm(w, (int8_t)-b);
+            float back = w == 1 && !turn_wheel_1 ? 0 : wheel_rpm(w, (int8_t)b);
+            cal->addSample(w, (int8_t)-b, fwd == 0 ? 0 : fwd + noise);
+            cal->addSample(w, (int8_t)b, back == 0 ? 0 : back - noise);
+        }
+    }
+}
+
+// encoder_motor_set_speed_base() before calibration existed
+static uint8_t baseline_byte(float new_speed)
+{
+    float temp_speed = new_speed / 55.0f * 90.0f;
+    float rps = (float)(-temp_speed) / 60.0f;
+    float pps = rps * 680.0f;
+    return (uint8_t)((int)round(pps * 0.01f));
+}
+
+static bool near(float a, float b, float tol)
+{
+    return fabsf(a - b) <= tol;
+}
+
+int main(void)
+{
+    // The default mapping matches the old one for every speed in steps of 0.05
+    bool same = true;
+    for (int i = -2000; i <= 2000 && same; i++)
+    {
+        float speed = i * 0.05f;
+        same = (uint8_t)exonaut_speed_byte_default(speed) == baseline_byte(speed);
+        if (!same)
+            printf("speed %.2f: %d, baseline %d\n", speed, exonaut_speed_byte_default(speed), baseline_byte(speed));
+    }
+    check(same, "default speed byte matches the baseline mapping");
+    check(exonaut_speed_byte_default(0) == 0 && exonaut_speed_byte_default(100) == -19 && exonaut_speed_byte_default(-50) == 9, "default speed byte spot values");
+
+    ExoNaut_MotorCal sweeper;
+    check(!sweeper.addSample(2, -5, 10) && !sweeper.addSample(0, 0, 0), "bad wheel and zero byte refused");
+    sweep(&sweeper);
+    motor_cal_t cal;
+    memset(&cal, 0, sizeof(cal));
+    check(sweeper.fit(&cal, 1) && exonaut_motorcal_valid(&cal) && cal.motor_type == 1, "sweep fitted");
+
+    bool fit_ok = true;
+    for (int w = 0; w < 2; w++)
+    {
+        for (int d = 0; d < 2; d++)
+        {
+            const motor_cal_fit_t *f = &cal.fit[w][d];
+            const wheel_t *m = &wheels[w][d];
+            printf("wheel %d %s: gain %.3f offset %.3f deadband %d\n", w, d == 0 ? "forwards" : "backwards", f->gain, f->offset, f->deadband);
+            fit_ok = fit_ok && near(f->gain, m->gain, 0.05f) && near(f->offset, m->offset, 0.5f) && f->deadband == m->deadband;
+        }
+    }
+    check(fit_ok, "least squares gain, offset and deadband");
+
+    // Above the deadbands the bytes from the fit turn both wheels within half a
+    // byte's worth of the request
+    bool match = true;
+    for (int rpm = -80; rpm <= 80 && match; rpm += 5)
+    {
+        if (abs(rpm) < 10)
+            continue;
+        for (uint8_t w = 0; w < 2; w++)
+        {
+            float got = wheel_rpm(w, exonaut_motorcal_byte(&cal, w, (float)rpm));
+            match = match && near(got, (float)rpm, 3.1f);
+        }
+    }
+    check(match, "both wheels reach the requested speed");
+    check(exonaut_motorcal_byte(&cal, 0, 60) < 0 && exonaut_motorcal_byte(&cal, 0, -60) > 0, "positive speeds use negative bytes");
+    check(exonaut_motorcal_byte(&cal, 1, 60) < exonaut_motorcal_byte(&cal, 0, 60), "the weaker wheel gets a larger byte");
+
+    // Wheel 1 turns at 9.6 rpm at its deadband of 3: a request of 6 rpm jumps to it,
+    // a request of 2 rpm is closer to standing still
+    check(exonaut_motorcal_byte(&cal, 1, 6) == -3 && exonaut_motorcal_byte(&cal, 1, 2) == 0, "below the deadband");
+    check(exonaut_motorcal_byte(&cal, 0, 0) == 0 && exonaut_motorcal_byte(&cal, 2, 50) == 0, "stopped or bad wheel");
+    check(exonaut_motorcal_byte(&cal, 0, 5000) == -127, "clamped to the largest byte");
+
+    // A wheel that never turned cannot be fitted
+    ExoNaut_MotorCal stuck;
+    sweep(&stuck, false);
+    check(!stuck.fit(&cal, 1), "a wheel that did not turn fails the fit");
+
+    // A wheel turning the wrong way fits a negative gain and fails
+    ExoNaut_MotorCal backwards;
+    for (int b = 1; b <= MOTOR_CAL_SWEEP_MAX; b++)
+    {
+        for (uint8_t w = 0; w < 2; w++)
+        {
+            backwards.addSample(w, (int8_t)-b, w == 0 ? -wheel_rpm(w, (int8_t)-b) : wheel_rpm(w, (int8_t)-b));
+            backwards.addSample(w, (int8_t)b, wheel_rpm(w, (int8_t)b));
+        }
+    }
+    check(!backwards.fit(&cal, 1), "a wheel wired backwards fails the fit");
+
+    cal.magic = 0;
+    check(!exonaut_motorcal_valid(&cal), "no magic, not valid");
+
+    return test_result();
+}
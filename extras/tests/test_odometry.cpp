@@ -0,0 +1,128 @@
+/*
+ * test_odometry.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * Feeds a recorded count sequence (a straight run, a 90 degree turn on the
+ * spot and a second straight run, at the 50 Hz stream rate) through both
+ * odometry paths: the float one and the fixed point CORDIC one, built here in
+ * namespace fixed_point with EXONAUT_ODOM_FIXED_POINT set.  Checks each pose
+ * against the one worked out from the wheel geometry, that the two paths
+ * agree, and that the counts wrapping past INT32_MAX make no difference.
+ */
+
+#include "ExoNaut_Odometry.h"
+#include "test_util.h"
+#include <math.h>
+#include <stdio.h>
+
+// The same source again with the fixed point path
+namespace fixed_point
+{
+#undef EXONAUT_ODOMETRY_H
+#undef EXONAUT_ODOM_FIXED_POINT
+#define EXONAUT_ODOM_FIXED_POINT 1
+#include "../../src/ExoNaut_Odometry.cpp"
+}
+
+#define RADIUS 32.5f // EXONAUT_WHEEL_RADIUS_MM
+#define TRACK 190.0f // EXONAUT_WHEEL_TRACK_MM
+#define PULSES 1120  // PULSE_COUNT
+#define PI_F 3.14159265358979f
+
+static const float mm_per_pulse = 2.0f * PI_F * RADIUS / PULSES;
+
+// One recorded frame every 20 ms, counts relative to where the run starts
+typedef struct
+{
+    int32_t c1;
+    int32_t c2;
+} counts_t;
+
+static counts_t run[400];
+static int frames = 0;
+
+static void record(int n, int32_t step_1, int32_t step_2)
+{
+    for (int i = 0; i < n; i++, frames++)
+    {
+        counts_t prev = frames > 0 ? run[frames - 1] : counts_t{0, 0};
+        run[frames].c1 = prev.c1 + step_1;
+        run[frames].c2 = prev.c2 + step_2;
+    }
+}
+
+template <class Odometry, class Pose>
+static void replay(Odometry &odom, Pose *pose, int upto, int32_t base)
+{
+    odom.setGeometry(RADIUS, TRACK, PULSES);
+    odom.reset();
+    odom.update(base, base, 0); // latches the start counts
+    for (int i = 0; i < upto; i++)
+        odom.update((int32_t)((uint32_t)base + (uint32_t)run[i].c1), (int32_t)((uint32_t)base + (uint32_t)run[i].c2), (uint32_t)(i + 1) * 20000);
+    odom.getPose(pose);
+}
+
+static bool near(float a, float b, float tol)
+{
+    return fabsf(a - b) <= tol;
+}
+
+int main(void)
+{
+    record(100, 55, 55); // straight: 5500 pulses on each wheel
+    int straight = frames;
+    record(91, -9, 9);   // turn left on the spot: 1638 pulses of difference
+    int turned = frames;
+    record(100, 55, 55); // straight again, now along +y
+    const int32_t base = 0x7FFFFF00; // the counts wrap during the first run
+
+    const float run_mm = 5500 * mm_per_pulse;
+    const float turn_rad = 2 * 9 * 91 * mm_per_pulse / TRACK;
+
+    ExoNaut_Odometry fl;
+    fixed_point::ExoNaut_Odometry fx;
+    odom_pose_t pf;
+    fixed_point::odom_pose_t px;
+
+    // Straight run
+    replay(fl, &pf, straight, base);
+    replay(fx, &px, straight, base);
+    check(near(pf.x, run_mm, 0.01f) && near(pf.y, 0, 0.001f) && near(pf.heading, 0, 1e-6f), "float: straight run");
+    // mm per pulse is rounded to Q16 (about 15 um per metre) and CORDIC leaves a small sine at zero
+    check(near(px.x, run_mm, 0.02f) && near(px.y, 0, 0.005f) && near(px.heading, 0, 1e-6f), "fixed: straight run");
+    check(pf.updates == (uint32_t)straight && pf.timestamp_us == (uint32_t)straight * 20000, "updates and time of the last frame");
+    // Both wheels contribute noise * distance / 4 to the variance along the run
+    check(near(pf.cov[0], ODOM_NOISE * run_mm / 2, 1e-3f) && near(pf.cov[5], 2 * ODOM_NOISE * run_mm / (TRACK * TRACK), 1e-7f), "straight run covariance");
+
+    // 90 degree turn on the spot
+    replay(fl, &pf, turned, base);
+    replay(fx, &px, turned, base);
+    printf("turn: float %.4f rad, fixed %.4f rad, want %.4f\n", pf.heading, px.heading, turn_rad);
+    check(near(pf.heading, turn_rad, 1e-4f) && near(pf.x, run_mm, 0.01f) && near(pf.y, 0, 0.01f), "float: 90 degree turn");
+    check(near(px.heading, turn_rad, 1e-4f) && near(px.x, run_mm, 0.02f) && near(px.y, 0, 0.01f), "fixed: 90 degree turn");
+    check(fabsf(turn_rad - PI_F / 2) < 0.002f, "the recorded turn is 90 degrees");
+
+    // And a second run at that heading
+    replay(fl, &pf, frames, base);
+    replay(fx, &px, frames, base);
+    float want_x = run_mm + run_mm * cosf(turn_rad);
+    float want_y = run_mm * sinf(turn_rad);
+    printf("end: float (%.3f, %.3f), fixed (%.3f, %.3f), want (%.3f, %.3f)\n", pf.x, pf.y, px.x, px.y, want_x, want_y);
+    check(near(pf.x, want_x, 0.05f) && near(pf.y, want_y, 0.05f) && near(pf.heading, turn_rad, 1e-4f), "float: run after the turn");
+    check(near(px.x, want_x, 0.05f) && near(px.y, want_y, 0.05f) && near(px.heading, turn_rad, 1e-4f), "fixed: run after the turn");
+
+    // The two paths agree, covariance included (it is float in both)
+    check(near(pf.x, px.x, 0.02f) && near(pf.y, px.y, 0.02f) && near(pf.heading, px.heading, 1e-5f), "float and fixed poses agree");
+    bool cov_agree = true;
+    for (int i = 0; i < 6; i++)
+        cov_agree = cov_agree && near(pf.cov[i], px.cov[i], 1e-3f * (fabsf(pf.cov[i]) + 1e-6f));
+    check(cov_agree, "float and fixed covariance agree");
+
+    // Replaying from zero gives the same pose as replaying across the wrap
+    fixed_point::odom_pose_t p0;
+    replay(fx, &p0, frames, 0);
+    check(p0.x == px.x && p0.y == px.y && p0.heading == px.heading, "fixed: bit for bit across the count wrap");
+
+    return test_result();
+}
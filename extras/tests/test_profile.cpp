@@ -0,0 +1,128 @@
+/*
+ * test_profile.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * Plans trapezoid and S-curve profiles and samples them every millisecond.
+ * Checks that each starts and ends at rest on the requested distance, reaches
+ * the speed limit and never exceeds it or the acceleration limit, that short
+ * moves become triangles peaking at the speed the distance allows, that a
+ * negative distance mirrors a positive one, and that limits which are not
+ * positive are refused.
+ */
+
+#include "ExoNaut_Profile.h"
+#include "test_util.h"
+#include <math.h>
+#include <stdio.h>
+
+#define PI_F 3.14159265358979f
+#define DT 0.001f
+
+typedef struct
+{
+    float peak_v;    // highest |velocity| sampled
+    float peak_a;    // highest |acceleration| between samples
+    float max_jump;  // largest position change between samples, over |velocity| * DT
+    float end_pos;   // position sampled at duration()
+    float end_vel;
+    bool ended;      // sample() returned false at duration()
+} sweep_t;
+
+static sweep_t sweep(const ExoNaut_Profile &p)
+{
+    sweep_t s = {0, 0, 0, 0, 0, false};
+    float prev_p = 0, prev_v = 0;
+    p.sample(0, &prev_p, &prev_v);
+    for (float t = DT; t < p.duration(); t += DT)
+    {
+        float pos, vel;
+        p.sample(t, &pos, &vel);
+        float a = fabsf(vel - prev_v) / DT;
+        float jump = fabsf(pos - prev_p) - fmaxf(fabsf(vel), fabsf(prev_v)) * DT;
+        s.peak_v = fmaxf(s.peak_v, fabsf(vel));
+        s.peak_a = fmaxf(s.peak_a, a);
+        s.max_jump = fmaxf(s.max_jump, jump);
+        prev_p = pos;
+        prev_v = vel;
+    }
+    s.ended = !p.sample(p.duration(), &s.end_pos, &s.end_vel);
+    return s;
+}
+
+static bool near(float a, float b, float tol)
+{
+    return fabsf(a - b) <= tol;
+}
+
+int main(void)
+{
+    ExoNaut_Profile p;
+    float pos, vel;
+
+    // Trapezoid: 0.5 s ramps covering 50 mm each, 2 s cruising at 200 mm/s
+    check(p.plan(500, 200, 400), "trapezoid planned");
+    check(near(p.duration(), 3.0f, 1e-5f) && near(p.peakSpeed(), 200, 1e-4f), "trapezoid duration and peak");
+    check(p.sample(0, &pos, &vel) && pos == 0 && vel == 0, "trapezoid starts at rest");
+    p.sample(0.5f, &pos, &vel);
+    check(near(pos, 50, 1e-3f) && near(vel, 200, 1e-3f), "trapezoid ramp ends at the speed limit");
+    p.sample(1.5f, &pos, &vel);
+    check(near(pos, 250, 1e-3f) && vel == 200, "trapezoid halfway");
+    sweep_t s = sweep(p);
+    check(s.ended && s.end_pos == 500 && s.end_vel == 0, "trapezoid ends at rest on the distance");
+    check(near(s.peak_v, 200, 1e-3f) && s.peak_a <= 400 * 1.001f, "trapezoid within its limits");
+    check(s.max_jump < 1e-3f, "trapezoid position is continuous");
+
+    // S-curve: the same move ramps pi/2 times longer so its steepest point is the limit
+    check(p.plan(500, 200, 400, PROFILE_SCURVE), "S-curve planned");
+    float ramp_s = PI_F / 2 * 200 / 400;
+    check(near(p.duration(), 2 * ramp_s + (500 - 200 * ramp_s) / 200, 1e-4f), "S-curve duration");
+    p.sample(ramp_s, &pos, &vel);
+    check(near(pos, 100 * ramp_s, 1e-2f) && near(vel, 200, 1e-2f), "S-curve ramp ends at the speed limit");
+    p.sample(ramp_s / 2, &pos, &vel);
+    check(near(vel, 100, 1e-2f), "S-curve at half speed halfway up the ramp");
+    s = sweep(p);
+    check(s.ended && s.end_pos == 500 && s.end_vel == 0, "S-curve ends at rest on the distance");
+    check(near(s.peak_v, 200, 1e-2f), "S-curve reaches the speed limit");
+    printf("S-curve peak acceleration %.1f mm/s^2, limit 400\n", s.peak_a);
+    check(s.peak_a <= 400 * 1.001f && s.peak_a > 400 * 0.99f, "S-curve peak acceleration at the limit");
+    check(s.max_jump < 1e-3f, "S-curve position is continuous");
+    // The acceleration starts from zero: the first millisecond barely moves
+    p.sample(DT, &pos, &vel);
+    check(vel < 400 * DT * 0.01f, "S-curve acceleration starts at zero");
+
+    // Short trapezoid: 20 mm never reaches 200 mm/s, peak is sqrt(20 * 400)
+    check(p.plan(20, 200, 400), "short trapezoid planned");
+    float tri = sqrtf(20 * 400);
+    check(near(p.peakSpeed(), tri, 1e-3f) && near(p.duration(), 2 * tri / 400, 1e-5f), "triangle peak and duration");
+    p.sample(tri / 400, &pos, &vel);
+    check(near(pos, 10, 1e-3f) && near(vel, tri, 1e-3f), "triangle peaks halfway");
+    s = sweep(p);
+    check(s.ended && s.end_pos == 20 && s.end_vel == 0 && s.peak_v <= tri + 1e-3f, "triangle ends at rest on the distance");
+    check(s.peak_a <= 400 * 1.001f, "triangle within the acceleration limit");
+
+    // Short S-curve: total = (pi/2) * peak^2 / accel
+    check(p.plan(20, 200, 400, PROFILE_SCURVE), "short S-curve planned");
+    tri = sqrtf(20 * 400 / (PI_F / 2));
+    check(near(p.peakSpeed(), tri, 1e-3f) && near(p.duration(), 2 * (PI_F / 2) * tri / 400, 1e-4f), "S-curve triangle peak and duration");
+    s = sweep(p);
+    check(s.ended && s.end_pos == 20 && s.end_vel == 0, "S-curve triangle ends at rest on the distance");
+    check(s.peak_a <= 400 * 1.001f && s.max_jump < 1e-3f, "S-curve triangle within the acceleration limit");
+
+    // A negative distance (reversing, or a right turn) mirrors the positive one
+    p.plan(-500, 200, 400, PROFILE_SCURVE);
+    check(p.distance() == -500 && near(p.peakSpeed(), -200, 1e-4f), "negative distance and peak");
+    p.sample(1.0f, &pos, &vel);
+    ExoNaut_Profile q;
+    q.plan(500, 200, 400, PROFILE_SCURVE);
+    float qpos, qvel;
+    q.sample(1.0f, &qpos, &qvel);
+    check(pos == -qpos && vel == -qvel, "negative distance mirrors the positive");
+
+    // A zero distance is an empty profile
+    check(p.plan(0, 200, 400) && p.duration() == 0 && !p.sample(0, &pos, &vel) && pos == 0 && vel == 0, "zero distance");
+
+    check(!p.plan(100, 0, 400) && !p.plan(100, 200, -1), "limits that are not positive refused");
+
+    return test_result();
+}
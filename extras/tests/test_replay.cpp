@@ -0,0 +1,121 @@
+/*
+ * test_replay.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * Records a capture with ExoNaut_Capture the way rx_task and tx_task do, then
+ * replays it through exonaut_telemetry_replay() and checks the decoded state:
+ * encoder counts in both formats, battery voltage, IR events, an ack, a bus
+ * servo reply and the firmware version.  One frame is split across two reads
+ * and one has a bad hex digit, as happens on the wire.  A binary 'V' frame
+ * from a restarted co-processor must not make its next 'E' frame a gap, and
+ * a binary 'E' frame repeated or arriving late is skipped, not counted as 255
+ * frames lost.
+ */
+
+#include "ExoNaut_Telemetry.h"
+#include "ExoNaut_Capture.h"
+#include "test_util.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+static uint8_t log_buf[2048];
+static ExoNaut_Capture cap;
+static uint32_t now_us = 0;
+
+static void rx(const char *text)
+{
+    now_us += 5000;
+    cap.record(EXONAUT_CAPTURE_RX, now_us, (const uint8_t *)text, strlen(text));
+}
+
+static void rx_binary(uint8_t type, const uint8_t *payload, uint8_t len)
+{
+    uint8_t f[EXONAUT_BIN_PAYLOAD_MAX + EXONAUT_BIN_OVERHEAD];
+    f[0] = EXONAUT_BIN_SYNC;
+    f[1] = len;
+    f[2] = type;
+    memcpy(f + 3, payload, len);
+    f[3 + len] = exonaut_crc8(f + 1, len + 2);
+    now_us += 5000;
+    cap.record(EXONAUT_CAPTURE_RX, now_us, f, len + EXONAUT_BIN_OVERHEAD);
+}
+
+typedef struct
+{
+    uint32_t acks;
+    uint32_t presses;
+    uint32_t errors;
+    uint32_t encoders;
+    int32_t first_1; // counts from the first encoder frame
+    int32_t first_2;
+} seen_t;
+
+static void on_frame(uint8_t flags, const ExoNaut_Telemetry *telem, uint32_t time_us, void *arg)
+{
+    seen_t *seen = (seen_t *)arg;
+    if (flags & TELEM_ACK)
+        seen->acks++;
+    if (flags & TELEM_ERROR)
+        seen->errors++;
+    if ((flags & TELEM_ENCODER) && seen->encoders++ == 0)
+    {
+        seen->first_1 = telem->state.encoder.count_1;
+        seen->first_2 = telem->state.encoder.count_2;
+    }
+    for (uint8_t i = 0; i < telem->ir_event_count; i++)
+    {
+        if (telem->ir_events[i].event == IR_EVENT_PRESS && telem->ir_events[i].ir_code == 0x0C45)
+            seen->presses++;
+    }
+}
+
+int main(void)
+{
+    cap.begin(log_buf, sizeof(log_buf));
+
+    // set_motor_speed(50, 50): bytes of -9 for both wheels
+    const uint8_t speed[] = {0x55, 0x55, 0x05, 55, 0x02, 0xF7, 0xF7};
+    cap.record(EXONAUT_CAPTURE_TX, now_us, speed, sizeof(speed));
+
+    rx("V123$");
+    rx("A8F450C$");                           // 0x8F * 51.765 mV, IR key 0x0C45 pressed
+    rx("EMM00000064FFFFFF38$");               // motor 2 raw 100, motor 1 raw -200
+    rx("EMM0000006");                         // split across two reads
+    rx("EFFFFFF38$AOK$");                     // ...and an ack in the same read
+    rx("EMM0000006GFFFFFF38$");               // bad hex digit
+    rx("S0379010C1E2A$");                     // servo 3 at 0x0179, 7692 mV, 42 C
+
+    const uint8_t e[] = {7, 0x10, 0x00, 0x00, 0x00, 0xF0, 0xFF, 0xFF, 0xFF}; // raw 16 and -16
+    rx_binary('E', e, sizeof(e));
+    const uint8_t e2[] = {9, 0x11, 0x00, 0x00, 0x00, 0xEF, 0xFF, 0xFF, 0xFF}; // seq 8 lost on the wire
+    rx_binary('E', e2, sizeof(e2));
+    rx_binary('E', e2, sizeof(e2));                                            // repeated
+    rx_binary('E', e, sizeof(e));                                              // late
+    rx_binary('V', (const uint8_t *)"V200", 4);                                 // co-processor restarted
+    const uint8_t e3[] = {0, 0x12, 0x00, 0x00, 0x00, 0xEE, 0xFF, 0xFF, 0xFF}; // its sequence starts again at 0
+    rx_binary('E', e3, sizeof(e3));
+    size_t log_len = cap.length();
+    cap.end();
+
+    ExoNaut_Telemetry telem;
+    seen_t seen = {0, 0, 0, 0, 0, 0};
+    uint32_t frames = exonaut_telemetry_replay(log_buf, log_len, &telem, on_frame, &seen);
+
+    const coproc_state_t &st = telem.state;
+    check(frames == 13, "frame count");
+    check(strcmp(telem.version, "V200") == 0, "version");
+    check(fabsf(st.volt - 0x8F * 51.765f) < 0.1f, "battery voltage");
+    check(st.ir_key == 0x0C45 && seen.presses == 1, "IR press");
+    check(seen.acks == 1, "ack");
+    check(seen.errors == 1 && telem.frame_errors == 1, "bad hex digit rejected");
+    check(seen.encoders == 5 && st.encoder.seq == 5, "encoder frames");
+    check(seen.first_1 == 200 && seen.first_2 == -100, "ASCII counts, motor 2 first, negated");
+    check(st.encoder.count_1 == -18 && st.encoder.count_2 == 18, "binary counts, negated");
+    check(st.encoder.dropped == 2, "bad frame and sequence gap counted, none after the restart");
+    check(telem.servo.id == 3 && telem.servo.pos == 0x0179 && telem.servo.volt_mv == 0x1E0C && telem.servo.temp_c == 42, "servo reply");
+    check(telem.battery.status().volt > 0, "battery fed");
+    printf("%u frames, counts %d/%d, %.0f mV\n", frames, st.encoder.count_1, st.encoder.count_2, st.volt);
+    return test_result();
+}
@@ -0,0 +1,226 @@
+/*
+ * test_segment_follower.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * Runs ExoNaut_SegmentFollower the way ExoNaut_Motion does, every 20 ms on
+ * the latest 50 Hz encoder counts, against a simulated robot whose wheels lag
+ * their commands and do not turn at the commanded speed (one slower, one
+ * faster).  Checks that drives, turns and arcs end on the measured distance
+ * or heading rather than on the profile time, that a robot too slow for the
+ * profile keeps going until it arrives, that a blocked robot times out after
+ * the settle time and the next segment does not try to make up what it could
+ * not do, and that what a finished segment leaves over is made up by the next
+ * one, so a square comes back to where it started.
+ */
+
+#include "ExoNaut_SegmentFollower.h"
+#include "test_util.h"
+#include <math.h>
+#include <stdio.h>
+
+#define RADIUS 32.5f // EXONAUT_WHEEL_RADIUS_MM
+#define TRACK 190.0f // EXONAUT_WHEEL_TRACK_MM
+#define PULSES 1120  // PULSE_COUNT
+#define TICK_MS 20   // MOTION_TICK_MS
+#define TOL_MM 2.0f  // MOTION_TOLERANCE_MM
+#define TOL_DEG 1.0f // MOTION_TOLERANCE_DEG
+#define SETTLE_MS 1000
+#define PI_F 3.14159265358979f
+#define DEG_RAD (PI_F / 180.0f)
+
+// The robot, integrated every millisecond
+static struct
+{
+    float x, y, heading;  // world pose, mm and rad
+    float wheel[2];       // wheel travel, mm
+    float speed[2];       // wheel speed, mm/s
+    float gain[2];        // actual over commanded speed
+    float tau;            // s, wheel lag
+    float block_mm;       // the wheels stop once the robot has gone this far, 0 for never
+    float odo;            // centre line travel
+    int32_t base;         // counts at the start
+} bot = {0, 0, 0, {0, 0}, {0, 0}, {0.9f, 1.08f}, 0.06f, 0, 0, 0x7FFFFF00};
+
+static ExoNaut_SegmentFollower follower;
+static const float mm_per_pulse = 2.0f * PI_F * RADIUS / PULSES;
+
+static int32_t counts(int i)
+{
+    return (int32_t)((uint32_t)bot.base + (uint32_t)(int32_t)floorf(bot.wheel[i] / mm_per_pulse));
+}
+
+static void step_ms(float left, float right)
+{
+    const float dt = 0.001f;
+    float cmd[2] = {left, right};
+    for (int i = 0; i < 2; i++)
+    {
+        bot.speed[i] += (bot.gain[i] * cmd[i] - bot.speed[i]) * dt / bot.tau;
+        if (bot.block_mm > 0 && fabsf(bot.odo) >= bot.block_mm)
+            bot.speed[i] = 0;
+    }
+    float ds = 0.5f * (bot.speed[0] + bot.speed[1]) * dt;
+    float dh = (bot.speed[1] - bot.speed[0]) * dt / TRACK;
+    bot.x += ds * cosf(bot.heading + dh / 2);
+    bot.y += ds * sinf(bot.heading + dh / 2);
+    bot.heading += dh;
+    bot.odo += ds;
+    bot.wheel[0] += bot.speed[0] * dt;
+    bot.wheel[1] += bot.speed[1] * dt;
+}
+
+typedef struct
+{
+    uint8_t state;
+    float end_s; // when the segment ended
+} result_t;
+
+// Motion::runProfile(): sample the counts, command, wait a tick; halt and let the robot stop
+static result_t run(float distance, float speed, float accel, float kv, float kw, float tolerance)
+{
+    result_t r = {FOLLOW_RUNNING, 0};
+    if (!follower.start(distance, speed, accel, 0, kv, kw, tolerance, SETTLE_MS))
+    {
+        r.state = 0xFF;
+        return r;
+    }
+    int32_t c1 = counts(0), c2 = counts(1); // the latest 50 Hz frame
+    for (uint32_t ms = 0;; ms += TICK_MS)
+    {
+        float v, w;
+        r.state = follower.update(ms * 0.001f, c1, c2, &v, &w);
+        if (r.state != FOLLOW_RUNNING)
+        {
+            r.end_s = ms * 0.001f;
+            break;
+        }
+        for (int i = 0; i < TICK_MS; i++)
+            step_ms(v - w * TRACK * 0.5f, v + w * TRACK * 0.5f);
+        c1 = counts(0);
+        c2 = counts(1);
+    }
+    for (int i = 0; i < 500; i++)
+        step_ms(0, 0); // halt(), the wheels run down
+    return r;
+}
+
+static result_t drive(float mm)
+{
+    return run(mm, 150, 300, 1.0f, 0, TOL_MM);
+}
+
+static result_t turn(float deg)
+{
+    return run(deg, 90, 180, 0, DEG_RAD, TOL_DEG);
+}
+
+static bool near(float a, float b, float tol)
+{
+    return fabsf(a - b) <= tol;
+}
+
+static void place(void)
+{
+    bot.x = bot.y = bot.heading = bot.odo = 0;
+    follower.dropCarry();
+}
+
+int main(void)
+{
+    follower.setGeometry(RADIUS, TRACK, PULSES);
+
+    // A straight drive on mismatched wheels: ends on the measured distance, still straight.
+    // Open loop, the left wheel would fall 90 mm behind the right over 500 mm.
+    result_t r = drive(500);
+    printf("drive: (%.1f, %.1f) mm, heading %.2f deg, remaining %.2f mm, %.2f s of %.2f\n", bot.x, bot.y,
+           bot.heading / DEG_RAD, follower.remaining(), r.end_s, follower.duration());
+    check(r.state == FOLLOW_DONE && fabsf(follower.remaining()) <= TOL_MM, "drive ends on the measured distance");
+    check(fabsf(follower.headingError()) <= 1 * DEG_RAD, "drive holds its heading");
+    // Where the robot comes to rest also has the wheels running down after the halt
+    check(near(bot.x, 500, 5) && near(bot.y, 0, 10) && near(bot.heading, 0, 1.5f * DEG_RAD), "drive straight to the target");
+
+    // A quarter turn on the spot
+    place();
+    r = turn(90);
+    printf("turn: %.2f deg, centre (%.1f, %.1f)\n", bot.heading / DEG_RAD, bot.x, bot.y);
+    check(r.state == FOLLOW_DONE && fabsf(follower.remaining()) <= 2 * TOL_DEG, "turn ends on the measured heading");
+    check(near(bot.heading, 90 * DEG_RAD, 3 * DEG_RAD), "turn comes to rest at the target");
+    check(near(bot.x, 0, 5) && near(bot.y, 0, 5), "turn stays on the spot");
+
+    // A quarter circle of 200 mm radius to the left, backwards too
+    place();
+    r = run(200 * PI_F / 2, 150, 300, 1.0f, 1.0f / 200, TOL_MM);
+    printf("arc: (%.1f, %.1f) mm, heading %.2f deg\n", bot.x, bot.y, bot.heading / DEG_RAD);
+    check(r.state == FOLLOW_DONE && near(bot.x, 200, 8) && near(bot.y, 200, 8) && near(bot.heading, 90 * DEG_RAD, 2 * DEG_RAD), "arc");
+    place();
+    drive(-300);
+    check(near(bot.x, -300, 5) && near(bot.heading, 0, 1.5f * DEG_RAD), "drive backwards");
+
+    // Wheels at 80%: the profile runs out first and the robot keeps closing on the target
+    place();
+    bot.gain[0] = bot.gain[1] = 0.8f;
+    r = drive(300);
+    printf("slow robot: done after %.2f s, profile %.2f s\n", r.end_s, follower.duration());
+    check(r.state == FOLLOW_DONE && r.end_s > follower.duration() && near(bot.x, 300, 5), "a slow robot still arrives");
+    bot.gain[0] = 0.9f;
+    bot.gain[1] = 1.08f;
+
+    // Blocked after 100 mm: times out once the settle time has passed
+    place();
+    bot.block_mm = 100;
+    r = drive(500);
+    printf("blocked: %.2f s, remaining %.1f mm\n", r.end_s, follower.remaining());
+    check(r.state == FOLLOW_TIMEOUT && near(r.end_s, follower.duration() + SETTLE_MS * 0.001f, TICK_MS * 0.001f), "blocked drive times out");
+    check(near(follower.remaining(), 400, 3), "how far short it stopped is reported");
+    // Freed, the next drive does not lunge for the 400 mm as well
+    bot.block_mm = 0;
+    float x0 = bot.x;
+    r = drive(100);
+    printf("after the timeout: goal %.1f mm, moved %.1f mm\n", follower.goal(), bot.x - x0);
+    check(r.state == FOLLOW_DONE && follower.goal() == 100 && near(bot.x - x0, 100, 5), "nothing carried over a timeout");
+
+    // A turn's heading error is made up by the drive after it; a distance left
+    // over before the turn is not
+    place();
+    bot.block_mm = 30;
+    drive(100);
+    bot.block_mm = 0;
+    bot.gain[0] = bot.gain[1] = 0.8f;
+    run(90, 90, 180, 0, DEG_RAD, 6); // slow wheels and a coarse tolerance: stops short
+    float turned = bot.heading;
+    bot.gain[0] = 0.9f;
+    bot.gain[1] = 1.08f;
+    drive(200);
+    printf("turn then drive: turned %.2f deg, then (%.1f, %.1f) at %.2f deg\n", turned / DEG_RAD, bot.x, bot.y, bot.heading / DEG_RAD);
+    check(fabsf(turned - 90 * DEG_RAD) > 3 * DEG_RAD && near(bot.heading, 90 * DEG_RAD, 1.5f * DEG_RAD), "heading error steered out by the drive");
+    check(follower.goal() == 200, "no distance made up after a turn");
+
+    // The same heading error dropped, as cancel() does: the drive keeps the heading it starts with
+    place();
+    bot.gain[0] = bot.gain[1] = 0.8f;
+    run(90, 90, 180, 0, DEG_RAD, 6);
+    turned = bot.heading;
+    bot.gain[0] = 0.9f;
+    bot.gain[1] = 1.08f;
+    follower.dropCarry();
+    drive(200);
+    check(fabsf(turned - 90 * DEG_RAD) > 3 * DEG_RAD && near(bot.heading, turned, 1.5f * DEG_RAD), "dropped heading error");
+
+    // A square of four drives and left turns comes back to its start; only the
+    // last turn running down is not made up
+    place();
+    for (int side = 0; side < 4; side++)
+    {
+        drive(400);
+        turn(90);
+    }
+    printf("square: back at (%.1f, %.1f) mm, heading %.2f deg\n", bot.x, bot.y, bot.heading / DEG_RAD - 360);
+    check(near(bot.x, 0, 15) && near(bot.y, 0, 15) && near(bot.heading, 2 * PI_F, 3 * DEG_RAD), "square closes");
+
+    // Limits that are not positive, or a segment that neither drives nor turns
+    check(!follower.start(100, 0, 300, 0, 1.0f, 0, TOL_MM, SETTLE_MS) && !follower.start(100, 150, 300, 0, 0, 0, TOL_MM, SETTLE_MS),
+          "invalid segments refused");
+
+    return test_result();
+}
@@ -0,0 +1,153 @@
+/*
+ * test_seqlock.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * Stress test for ExoNaut_SeqLock.  One thread publishes coproc_state_t values
+ * whose fields are all derived from a single counter while reader threads
+ * check every copy they get for a mix of two updates.  The writer keeps going
+ * until every reader has seen MIN_FRESH_READS new values while it was still
+ * writing, so a run where the readers never overlapped the writer fails
+ * instead of passing unchecked.  Both sides yield now and then so that this
+ * also holds on a single core.
+ */
+
+#include "ExoNaut_SeqLock.h"
+#include "ExoNaut_Telemetry.h"
+#include <atomic>
+#include <chrono>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+#define WRITES 2000000         // at least this many
+#define READERS 3
+#define MIN_FRESH_READS 100000 // per reader, each a newer value than its last read, taken during the writes
+#define YIELD_EVERY 256        // writes between yields, so readers get a CPU on a single core
+#define TIME_LIMIT_S 60
+
+static void fill(coproc_state_t *s, uint32_t n)
+{
+    s->encoder.count_1 = (int32_t)n;
+    s->encoder.count_2 = -(int32_t)n;
+    s->encoder.timestamp_us = n * 3u;
+    s->encoder.seq = n;
+    s->encoder.dropped = n ^ 0x5A5A5A5Au;
+    s->volt = (float)(n & 0xFFFF);
+    s->ir_key = (uint16_t)(n * 7u);
+    s->battery.volt = (float)(n & 0xFFFF);
+    s->battery.open_circuit = (float)((n * 5u) & 0xFFFF);
+    s->battery.sag_per_speed = 0;
+    s->battery.full_load = 0;
+    s->battery.speed_limit = 0;
+    s->battery.level = (uint8_t)n;
+}
+
+static bool consistent(const coproc_state_t *s)
+{
+    coproc_state_t expect;
+    fill(&expect, s->encoder.seq);
+    return s->encoder.count_1 == expect.encoder.count_1 && s->encoder.count_2 == expect.encoder.count_2 &&
+           s->encoder.timestamp_us == expect.encoder.timestamp_us && s->encoder.dropped == expect.encoder.dropped &&
+           s->volt == expect.volt && s->ir_key == expect.ir_key && s->battery.volt == expect.battery.volt &&
+           s->battery.open_circuit == expect.battery.open_circuit && s->battery.level == expect.battery.level;
+}
+
+int main(void)
+{
+    static ExoNaut_SeqLock<coproc_state_t> lock;
+    coproc_state_t first;
+    fill(&first, 0);
+    lock.write(first);
+
+    std::atomic<bool> done(false);
+    std::atomic<uint32_t> torn(0);
+    std::atomic<uint32_t> backwards(0);
+    std::atomic<uint64_t> reads(0);
+    std::atomic<uint64_t> fresh[READERS];
+    std::vector<std::thread> readers;
+    for (int r = 0; r < READERS; r++)
+    {
+        fresh[r] = 0;
+        readers.emplace_back([&, r]() {
+            uint32_t last = 0;
+            uint64_t n = 0;
+            while (!done.load(std::memory_order_relaxed))
+            {
+                coproc_state_t s;
+                lock.read(&s);
+                if (!consistent(&s))
+                {
+                    torn++;
+                }
+                if (s.encoder.seq < last)
+                {
+                    backwards++;
+                }
+                else if (s.encoder.seq > last)
+                {
+                    fresh[r].fetch_add(1, std::memory_order_relaxed); // the writer has moved on since the last read
+                }
+                else
+                {
+                    std::this_thread::yield(); // nothing new; on a single core the writer needs the CPU
+                }
+                last = s.encoder.seq;
+                n++;
+            }
+            reads += n;
+        });
+    }
+
+    // Keep writing until every reader has overlapped the writer enough
+    auto overlapped = [&]() {
+        for (int r = 0; r < READERS; r++)
+        {
+            if (fresh[r].load(std::memory_order_relaxed) < MIN_FRESH_READS)
+                return false;
+        }
+        return true;
+    };
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(TIME_LIMIT_S);
+    uint32_t writes = 0;
+    bool timed_out = false;
+    while (writes < WRITES || !overlapped())
+    {
+        coproc_state_t s;
+        fill(&s, ++writes);
+        lock.write(s);
+        if (writes % YIELD_EVERY == 0)
+        {
+            std::this_thread::yield();
+            if (std::chrono::steady_clock::now() > deadline)
+            {
+                timed_out = true;
+                break;
+            }
+        }
+    }
+    done = true;
+    for (auto &t : readers)
+    {
+        t.join();
+    }
+
+    uint64_t least = fresh[0];
+    for (int r = 1; r < READERS; r++)
+    {
+        least = fresh[r] < least ? fresh[r].load() : least;
+    }
+    printf("%u writes, %llu reads, fewest fresh reads by one reader %llu, %u torn, %u out of order\n", writes,
+           (unsigned long long)reads.load(), (unsigned long long)least, torn.load(), backwards.load());
+    if (timed_out || least < MIN_FRESH_READS)
+    {
+        printf("FAIL: readers did not overlap the writer\n");
+        return 1;
+    }
+    if (torn != 0 || backwards != 0 || lock.version() != writes + 1)
+    {
+        printf("FAIL\n");
+        return 1;
+    }
+    return 0;
+}
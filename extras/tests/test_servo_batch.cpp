@@ -0,0 +1,55 @@
+/*
+ * test_servo_batch.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * Checks the multi-servo move packet: LEN = COUNT * 3 + 5, one header for
+ * the batch, and each servo's bytes laid out exactly as the single servo
+ * packet the library always sent (55 55 08 03 01 tl th id pl ph).
+ */
+
+#include "ExoNaut_BusServo.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <string.h>
+
+int main(void)
+{
+    uint8_t buf[BUS_SERVO_PACKET_SIZE(BUS_SERVO_MAX_BATCH)];
+
+    // One servo: byte for byte the original bus_servo_set_pose() packet
+    bus_servo_pose_t one = {7, 0x0234};
+    const uint8_t single[] = {0x55, 0x55, 0x08, 0x03, 0x01, 0xE8, 0x03, 7, 0x34, 0x02};
+    check(exonaut_servo_encode_move(&one, 1, 1000, buf, sizeof(buf)) == sizeof(single), "single length");
+    check(memcmp(buf, single, sizeof(single)) == 0, "single layout");
+
+    // Every batch size: header, LEN, and each servo as its single packet encodes it
+    bus_servo_pose_t poses[BUS_SERVO_MAX_BATCH];
+    for (uint8_t n = 1; n <= BUS_SERVO_MAX_BATCH; n++)
+    {
+        for (uint8_t i = 0; i < n; i++)
+        {
+            poses[i].id = (uint8_t)(i + 1);
+            poses[i].pos = (uint16_t)(100 * i + 37);
+        }
+        size_t len = exonaut_servo_encode_move(poses, n, 0x1234, buf, sizeof(buf));
+        check(len == (size_t)n * 3 + 7, "batch length");
+        check(buf[0] == 0x55 && buf[1] == 0x55, "batch header");
+        check(buf[2] == n * 3 + 5, "LEN = COUNT * 3 + 5");
+        check(buf[3] == BUS_SERVO_CMD_MOVE && buf[4] == n, "command and count");
+        check(buf[5] == 0x34 && buf[6] == 0x12, "time little endian");
+        for (uint8_t i = 0; i < n; i++)
+        {
+            uint8_t ref[BUS_SERVO_PACKET_SIZE(1)];
+            exonaut_servo_encode_move(&poses[i], 1, 0x1234, ref, sizeof(ref));
+            check(memcmp(&buf[7 + 3 * i], &ref[7], 3) == 0, "servo bytes match the single packet");
+        }
+    }
+
+    // Rejected batches
+    check(exonaut_servo_encode_move(poses, 0, 100, buf, sizeof(buf)) == 0, "empty batch");
+    check(exonaut_servo_encode_move(poses, BUS_SERVO_MAX_BATCH + 1, 100, buf, sizeof(buf)) == 0, "batch too large");
+    check(exonaut_servo_encode_move(poses, 2, 100, buf, BUS_SERVO_PACKET_SIZE(2) - 1) == 0, "buffer too small");
+
+    return test_result();
+}
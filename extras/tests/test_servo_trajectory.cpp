@@ -0,0 +1,87 @@
+/*
+ * test_servo_trajectory.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * Golden timeline for ExoNaut_ServoTrajectory: two servos, three keyframes,
+ * sampled every 60 ms with the minimum jerk and the Catmull-Rom cubic
+ * interpolation.  The expected positions were worked out by hand from the
+ * curve formulas, so a change to the sampler shows up as a changed packet.
+ */
+
+#include "ExoNaut_ServoTrajectory.h"
+#include "test_util.h"
+#include <stdio.h>
+
+typedef struct
+{
+    uint32_t t_ms;
+    uint16_t pos[2];
+    bool more;
+} golden_t;
+
+// Keyframes: 0 ms {200, 800}, 400 ms {600, 300}, 1000 ms {300, 300}
+static const golden_t min_jerk[] = {
+    {0, {200, 800}, true}, {20, {200, 799}, true}, {80, {223, 771}, true}, {140, {294, 682}, true},
+    {200, {400, 550}, true}, {260, {506, 418}, true}, {320, {577, 329}, true}, {380, {600, 301}, true},
+    {400, {600, 300}, true}, {440, {599, 300}, true}, {500, {589, 300}, true}, {560, {563, 300}, true},
+    {620, {522, 300}, true}, {680, {469, 300}, true}, {740, {413, 300}, true}, {800, {363, 300}, true},
+    {860, {326, 300}, true}, {920, {306, 300}, true}, {980, {300, 300}, true}, {1000, {300, 300}, false},
+    {1100, {300, 300}, false},
+};
+
+// The spline keeps moving through the middle keyframe, so servo 2 overshoots below 300
+static const golden_t cubic[] = {
+    {0, {200, 800}, true}, {20, {203, 797}, true}, {80, {240, 754}, true}, {140, {310, 675}, true},
+    {200, {395, 575}, true}, {260, {481, 470}, true}, {320, {553, 378}, true}, {380, {595, 313}, true},
+    {400, {600, 300}, true}, {440, {600, 283}, true}, {500, {585, 265}, true}, {560, {556, 257}, true},
+    {620, {517, 256}, true}, {680, {473, 260}, true}, {740, {427, 268}, true}, {800, {382, 278}, true},
+    {860, {344, 287}, true}, {920, {316, 295}, true}, {980, {301, 300}, true}, {1000, {300, 300}, false},
+    {1100, {300, 300}, false},
+};
+
+static void run(const ExoNaut_ServoTrajectory &traj, const golden_t *golden, size_t n, const char *name)
+{
+    bus_servo_pose_t poses[BUS_SERVO_MAX_BATCH];
+    for (size_t i = 0; i < n; i++)
+    {
+        bool more = traj.sample(golden[i].t_ms, poses);
+        bool ok = more == golden[i].more && poses[0].id == 3 && poses[1].id == 5 &&
+                  poses[0].pos == golden[i].pos[0] && poses[1].pos == golden[i].pos[1];
+        if (!ok)
+        {
+            printf("%s at %u ms: got %u %u, want %u %u\n", name, (unsigned)golden[i].t_ms, poses[0].pos, poses[1].pos,
+                   golden[i].pos[0], golden[i].pos[1]);
+        }
+        check(ok, name);
+    }
+}
+
+int main(void)
+{
+    const uint8_t ids[] = {3, 5};
+    const uint16_t k0[] = {200, 800}, k1[] = {600, 300}, k2[] = {300, 300};
+    ExoNaut_ServoTrajectory traj;
+    check(traj.setServos(ids, 2), "setServos");
+    check(traj.addKeyframe(0, k0) && traj.addKeyframe(400, k1) && traj.addKeyframe(1000, k2), "addKeyframe");
+    check(!traj.addKeyframe(1000, k2), "keyframe times must increase");
+    check(traj.duration() == 1000, "duration");
+
+    run(traj, min_jerk, sizeof(min_jerk) / sizeof(min_jerk[0]), "min jerk");
+
+    // The packet a player sends at 500 ms with a 20 ms move
+    uint8_t buf[BUS_SERVO_PACKET_SIZE(2)];
+    const uint8_t packet[] = {0x55, 0x55, 0x0B, 0x03, 0x02, 20, 0, 3, 589 & 0xFF, 589 >> 8, 5, 300 & 0xFF, 300 >> 8};
+    check(traj.packetAt(500, 20, buf, sizeof(buf)) == sizeof(packet), "packet length");
+    bool same = true;
+    for (size_t i = 0; i < sizeof(packet); i++)
+    {
+        same = same && buf[i] == packet[i];
+    }
+    check(same, "packet bytes");
+
+    traj.setInterpolation(SERVO_TRAJ_CUBIC);
+    run(traj, cubic, sizeof(cubic) / sizeof(cubic[0]), "cubic");
+
+    return test_result();
+}
@@ -0,0 +1,32 @@
+/*
+ * test_util.h
+ *
+ * Date: October 16th, 2026
+ *
+ * Shared by the host tests.  check() reports a failed condition and keeps
+ * going, so one run lists every failure; main() ends with
+ * return test_result();
+ */
+
+#ifndef EXONAUT_TEST_UTIL_H
+#define EXONAUT_TEST_UTIL_H
+
+#include <stdio.h>
+
+static int failures = 0;
+
+static void check(bool ok, const char *what)
+{
+    if (!ok)
+    {
+        printf("FAIL: %s\n", what);
+        ++failures;
+    }
+}
+
+static int test_result(void)
+{
+    return failures == 0 ? 0 : 1;
+}
+
+#endif // EXONAUT_TEST_UTIL_H
@@ -2,10 +2,20 @@
 
 #include <Arduino.h>
 #include "ExoNaut.h" // This now correctly includes ExoNautPixel.h
+#include "ExoNaut_Framer.h"
+#include "ExoNaut_AckTracker.h"
+#include "ExoNaut_SeqLock.h"
+#include <Preferences.h>
 #include <Wire.h>
+#include <atomic>
 // #include <Adafruit_NeoPixel.h> // REMOVED - Ensure this is gone
 
 void rx_task(void *pvParameter); // Forward declaration
+void tx_task(void *pvParameter);
+
+#if EXONAUT_RX_EVENT_DRIVEN
+static TaskHandle_t rx_task_notify = NULL; // rx_task handle for the UART receive callback
+#endif
 
 // Use the integrated ExoNautPixelController for onboard LEDs
 // NUM_PIXELS and NEO_PIXEL_PIN are defined in ExoNaut.h
@@ -21,6 +31,7 @@ uart2_obj_t uart2_obj = {
 	.initilized = false,
 	.volt = -1,
 	.version = "",
+	.binary = false,
 };
 
 ir_obj_t ir = {
@@ -40,6 +51,100 @@ encoder_motor_obj_t encoder_motor = {
 	.count_base_2 = 0,
 };
 
+static float wheel_radius_mm = EXONAUT_WHEEL_RADIUS_MM;
+static float wheel_track_mm = EXONAUT_WHEEL_TRACK_MM;
+
+// rx_task state
+static battery_callback_t battery_cb = NULL;
+static void *battery_cb_arg = NULL;
+static ir_callback_t ir_cb = NULL;
+static void *ir_cb_arg = NULL;
+static volatile uint32_t rx_binary_frames = 0; // valid binary frames, used to confirm the mode switch
+static uint32_t rx_stamp_us = 0;			   // micros() at the UART read that delivered the current frame
+// rx_task decodes into rx_telem.state and publishes it through coproc_state;
+// other tasks only ever read the published copy.
+static ExoNaut_Telemetry rx_telem;
+static ExoNaut_SeqLock<coproc_state_t> coproc_state;
+static volatile uint32_t encoder_request_seq = 0; // encoder seq when the last request went out
+static volatile TaskHandle_t encoder_waiters[EXONAUT_ENCODER_WAITERS]; // tasks blocked in wait_encoder_count()
+static portMUX_TYPE encoder_waiter_mux = portMUX_INITIALIZER_UNLOCKED;
+static struct
+{
+	encoder_callback_t cb;
+	void *arg;
+} encoder_listeners[EXONAUT_ENCODER_LISTENERS];
+static portMUX_TYPE encoder_listener_mux = portMUX_INITIALIZER_UNLOCKED;
+// rx_task bumps the generation before and after each callback, so it is odd while
+// one runs; remove_encoder_listener() waits for it to move past a running callback
+static volatile uint32_t encoder_dispatch_gen = 0;
+static volatile int8_t encoder_dispatch_slot = -1; // listener slot being called, -1 for none
+static TaskHandle_t rx_task_self = NULL;
+
+// Encoder history.  Each slot's seq is cleared while it is rewritten, so a
+// reader that sees the same seq before and after copying has a whole sample.
+static encoder_snapshot_t encoder_history[EXONAUT_ENCODER_HISTORY];
+static std::atomic<uint32_t> encoder_history_seq(0); // seq of the newest complete slot
+static TimerHandle_t encoder_stream_timer = NULL;
+static bool encoder_stream_remote = false; // co-processor is streaming by itself
+static volatile uint16_t encoder_stream_hz = 0;
+// Rate asked for by each start_encoder_stream() user, 0 = free; the stream runs at the highest
+static uint16_t encoder_stream_claims[EXONAUT_STREAM_USERS];
+static portMUX_TYPE encoder_stream_mux = portMUX_INITIALIZER_UNLOCKED;
+// Held while the stream is switched to the claimed rate; the timer and UART calls can block, so not the portMUX
+static SemaphoreHandle_t encoder_stream_lock = NULL;
+
+// Encoder turn; the listener runs in rx_task and the timeout in the timer task.
+// The timeout only ends the turn: removing the listener and the stream claim
+// can block, so that is left to the listener on the next frame, or to the task
+// that cancels or starts a turn, and never holds up the timer task.
+static struct
+{
+	volatile exonaut_turn_state_t state;
+	float target_deg; // signed, positive turns left (counter-clockwise)
+	float tolerance_deg;
+	float speed;	  // deg/s
+	float command;	  // last wheel speed sent
+	bool have_start;  // start counts taken from the first frame
+	int32_t start_1;
+	int32_t start_2;
+	float last_yaw;
+	volatile float turned_deg;
+	bool own_stream; // holds a stream claim for this turn
+	volatile bool release_pending; // ended, the listener, timer and stream claim still held
+	volatile bool releasing;	   // a task is letting them go
+	TimerHandle_t timer;
+	volatile TaskHandle_t waiter;
+} turn = {EXONAUT_TURN_IDLE, 0, 0, 0, 0, false, 0, 0, 0, 0, false, false, false, NULL, NULL};
+static turn_callback_t turn_cb = NULL;
+static void *turn_cb_arg = NULL;
+static yaw_source_t turn_yaw = NULL;
+static void *turn_yaw_arg = NULL;
+static portMUX_TYPE turn_mux = portMUX_INITIALIZER_UNLOCKED;
+static void turn_release(exonaut *robot);
+
+// Bus servo replies, written by rx_task
+typedef struct
+{
+	bus_servo_state_t servo[BUS_SERVO_TRACKED]; // slots with updates == 0 are free
+} servo_table_t;
+static servo_table_t rx_servos;
+static ExoNaut_SeqLock<servo_table_t> servo_table;
+
+// Odometry, integrated in rx_task and published through a seqlock
+static ExoNaut_Odometry odom;
+static ExoNaut_SeqLock<odom_pose_t> odom_pose;
+static volatile bool odom_running = false;
+static volatile bool odom_configure = true; // geometry or pulse count changed
+static volatile bool odom_reset_pending = false;
+static float odom_reset_pose[3];
+static uint16_t odom_stream_hz = 0; // rate claimed from start_encoder_stream()
+static portMUX_TYPE odom_mux = portMUX_INITIALIZER_UNLOCKED;
+
+// Motor calibration, used by speed_byte() when it matches the motor type
+static motor_cal_t motor_cal;
+static bool motor_cal_loaded = false;
+static portMUX_TYPE motor_cal_mux = portMUX_INITIALIZER_UNLOCKED;
+
 // --- Helper function (fine here) ---
 inline uint8_t hex2int(uint8_t ch)
 {
@@ -59,6 +164,287 @@ inline uint8_t hex2int(uint8_t ch)
 }
 // HEX_TO_INT macro is in ExoNaut.h, which is good
 
+// --- tx_task (Co-processor commands) ---
+typedef struct __tx_packet_t
+{
+	uint8_t len;
+	uint32_t ack_id; // non-zero: tracked until the co-processor acks it
+	uint8_t data[EXONAUT_TX_PACKET_MAX];
+} tx_packet_t;
+
+static QueueHandle_t tx_queue = NULL;	  // untracked packets, sent as soon as tx_task runs
+static QueueHandle_t tx_ack_queue = NULL; // tracked commands, sent one at a time
+static TaskHandle_t tx_task_notify = NULL;
+static uint8_t tx_speed_packet[7];		  // newest motor speed packet not yet sent
+static uint32_t tx_speed_id = 0;		  // its command id when it is tracked
+static bool tx_speed_pending = false;
+static portMUX_TYPE tx_speed_mux = portMUX_INITIALIZER_UNLOCKED;
+static volatile uint16_t tx_motor_interval_ms = EXONAUT_MOTOR_INTERVAL_MS;
+static volatile uint32_t tx_overflows = 0; // packets dropped because a queue was full
+
+// Acknowledged commands.  The co-processor acks every motor command at once and
+// a servo move when it ends, with no id in the reply (see ExoNaut_AckTracker.h).
+// tx_task reports every packet it writes to tx_acks, which gives each ack to the
+// packet whose ack was due first.  Untracked packets never wait; tracked
+// commands go out one at a time, except a tracked stop, which uses the speed
+// path and so never waits behind a servo move.
+static volatile bool ack_mode = false;
+static volatile uint16_t ack_timeout_ms = EXONAUT_ACK_TIMEOUT_MS;
+static volatile uint8_t ack_retries = EXONAUT_ACK_RETRIES;
+static uint32_t ack_next_id = 0; // last id handed out
+static volatile uint32_t ack_slot_id[EXONAUT_ACK_HISTORY]; // id whose result is in the matching ack_result slot
+static volatile uint8_t ack_result[EXONAUT_ACK_HISTORY];
+static volatile TaskHandle_t ack_waiters[EXONAUT_ACK_WAITERS]; // tasks blocked in wait_command()
+static portMUX_TYPE ack_waiter_mux = portMUX_INITIALIZER_UNLOCKED;
+static exonaut_cmd_callback_t ack_timeout_cb = NULL;
+static void *ack_timeout_arg = NULL;
+static portMUX_TYPE ack_mux = portMUX_INITIALIZER_UNLOCKED;
+static ExoNaut_AckTracker tx_acks;	   // only used by tx_task
+static volatile uint32_t rx_acks = 0; // acks decoded by rx_task
+
+// Capture of the link traffic; rx_task and tx_task both append to it
+static ExoNaut_Capture capture;
+static uint8_t *capture_buf = NULL;
+static volatile bool capture_on = false;
+static portMUX_TYPE capture_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static void capture_record(uint8_t dir, const uint8_t *data, size_t len)
+{
+	if (!capture_on)
+		return;
+	uint32_t now = micros();
+	portENTER_CRITICAL(&capture_mux);
+	capture.record(dir, now, data, len);
+	portEXIT_CRITICAL(&capture_mux);
+}
+
+static void uart_write(const uint8_t *buf, size_t len)
+{
+	capture_record(EXONAUT_CAPTURE_TX, buf, len);
+	ets_serial.write(buf, len);
+}
+
+static bool tx_enqueue(QueueHandle_t queue, const uint8_t *buf, uint8_t len, uint32_t ack_id)
+{
+	tx_packet_t pkt;
+	pkt.len = len > EXONAUT_TX_PACKET_MAX ? EXONAUT_TX_PACKET_MAX : len;
+	pkt.ack_id = ack_id;
+	memcpy(pkt.data, buf, pkt.len);
+	if (xQueueSend(queue, &pkt, 0) != pdTRUE)
+	{
+		++tx_overflows;
+		return false;
+	}
+	xTaskNotifyGive(tx_task_notify);
+	return true;
+}
+
+// Queue a packet for tx_task; never blocks.  Before begin() starts tx_task the
+// packet is written directly.
+static bool tx_send(const uint8_t *buf, uint8_t len)
+{
+	if (tx_task_notify == NULL)
+	{
+		uart_write(buf, len);
+		return true;
+	}
+	return tx_enqueue(tx_queue, buf, len, 0);
+}
+
+// Next command id in acknowledged mode, 0 when commands are not tracked
+static uint32_t ack_new_id(void)
+{
+	if (!ack_mode || tx_task_notify == NULL)
+		return 0;
+	portENTER_CRITICAL(&ack_mux);
+	uint32_t id = ++ack_next_id;
+	if (id == 0)
+		id = ++ack_next_id; // 0 means untracked
+	ack_result[id % EXONAUT_ACK_HISTORY] = EXONAUT_CMD_PENDING;
+	ack_slot_id[id % EXONAUT_ACK_HISTORY] = id;
+	portEXIT_CRITICAL(&ack_mux);
+	return id;
+}
+
+// Like tx_send(), but in acknowledged mode the packet is tracked until the
+// co-processor acks it, and resent if the ack does not come.  Returns the
+// command id, or 0 when not tracked.
+static uint32_t tx_send_acked(const uint8_t *buf, uint8_t len)
+{
+	uint32_t id = ack_new_id();
+	if (id == 0)
+	{
+		tx_send(buf, len);
+		return 0;
+	}
+	if (!tx_enqueue(tx_ack_queue, buf, len, id))
+		ack_result[id % EXONAUT_ACK_HISTORY] = EXONAUT_CMD_TIMEOUT; // never sent
+	return id;
+}
+
+static void ack_resolve(uint32_t id, uint8_t result)
+{
+	if (ack_slot_id[id % EXONAUT_ACK_HISTORY] == id)
+		ack_result[id % EXONAUT_ACK_HISTORY] = result;
+	for (int i = 0; i < EXONAUT_ACK_WAITERS; ++i)
+	{
+		TaskHandle_t waiter = ack_waiters[i];
+		if (waiter != NULL)
+			xTaskNotifyGive(waiter);
+	}
+	if (result == EXONAUT_CMD_TIMEOUT && ack_timeout_cb != NULL)
+		ack_timeout_cb(id, ack_timeout_arg);
+}
+
+// Replace any motor speed packet still waiting to go out.  A tracked packet
+// (ack_id != 0) that is replaced before it is sent is reported as replaced.
+static void tx_send_speed(const uint8_t buf[7], uint32_t ack_id = 0)
+{
+	if (tx_task_notify == NULL)
+	{
+		uart_write(buf, 7);
+		return;
+	}
+	portENTER_CRITICAL(&tx_speed_mux);
+	uint32_t replaced = tx_speed_pending ? tx_speed_id : 0;
+	memcpy(tx_speed_packet, buf, 7);
+	tx_speed_id = ack_id;
+	tx_speed_pending = true;
+	portEXIT_CRITICAL(&tx_speed_mux);
+	if (replaced != 0)
+		ack_resolve(replaced, EXONAUT_CMD_REPLACED);
+	xTaskNotifyGive(tx_task_notify);
+}
+
+static uint32_t tx_now_ms(void)
+{
+	return (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+}
+
+static void tx_write(const uint8_t *buf, uint8_t len, uint32_t ack_id)
+{
+	if (ack_id != 0)
+		action_finish = false;
+	uart_write(buf, len);
+	tx_acks.sent(buf, len, ack_id, tx_now_ms());
+}
+
+void tx_task(void *pvParameter)
+{
+	tx_packet_t pkt;
+	uint32_t acks_seen = rx_acks;
+	uint8_t speed_buf[7];
+	uint32_t speed_id;
+	TickType_t last_speed = xTaskGetTickCount() - pdMS_TO_TICKS(tx_motor_interval_ms);
+	TickType_t wait = portMAX_DELAY;
+
+	for (;;)
+	{
+		ulTaskNotifyTake(pdTRUE, wait);
+		tx_acks.setTimeout(ack_timeout_ms, ack_retries);
+
+		// Match the acks that came in before anything new goes out
+		for (uint32_t acks = rx_acks; acks_seen != acks; ++acks_seen)
+			tx_acks.acked(tx_now_ms());
+		ack_event_t ev;
+		while (tx_acks.poll(tx_now_ms(), &ev))
+		{
+			switch (ev.type)
+			{
+			case ACK_EVENT_RESEND:
+				uart_write(ev.data, ev.len);
+				break;
+			case ACK_EVENT_DONE:
+				ack_resolve(ev.id, EXONAUT_CMD_DONE);
+				break;
+			case ACK_EVENT_REPLACED:
+				ack_resolve(ev.id, EXONAUT_CMD_REPLACED);
+				break;
+			default:
+				ack_resolve(ev.id, EXONAUT_CMD_TIMEOUT);
+				break;
+			}
+		}
+
+		// Untracked packets, such as encoder count requests, never wait behind a command
+		while (xQueueReceive(tx_queue, &pkt, 0) == pdTRUE)
+			tx_write(pkt.data, pkt.len, 0);
+		// Tracked commands go out one at a time, each once the previous one is settled
+		if (!tx_acks.busy() && xQueueReceive(tx_ack_queue, &pkt, 0) == pdTRUE)
+			tx_write(pkt.data, pkt.len, pkt.ack_id);
+
+		// Speed packets are rate limited but never wait on a servo move
+		if (tx_speed_pending)
+		{
+			TickType_t since = xTaskGetTickCount() - last_speed;
+			TickType_t interval = pdMS_TO_TICKS(tx_motor_interval_ms);
+			if (since >= interval)
+			{
+				portENTER_CRITICAL(&tx_speed_mux);
+				memcpy(speed_buf, tx_speed_packet, 7);
+				speed_id = tx_speed_id;
+				tx_speed_pending = false;
+				portEXIT_CRITICAL(&tx_speed_mux);
+				tx_write(speed_buf, 7, speed_id);
+				last_speed = xTaskGetTickCount();
+			}
+		}
+
+		// Sleep until a notification, the next ack deadline or the end of the speed interval
+		int32_t next = tx_acks.nextDeadline(tx_now_ms());
+		wait = next < 0 ? portMAX_DELAY : pdMS_TO_TICKS(next);
+		if (tx_speed_pending)
+		{
+			TickType_t since = xTaskGetTickCount() - last_speed;
+			TickType_t interval = pdMS_TO_TICKS(tx_motor_interval_ms);
+			TickType_t left = since < interval ? interval - since : 0;
+			if (left < wait)
+				wait = left;
+		}
+	}
+}
+
+// --- Motor speed mapping ---
+// Speed byte for wheel 0 or 1 at speed in set_motor_speed() units
+static int8_t speed_byte(uint8_t wheel, float speed)
+{
+	portENTER_CRITICAL(&motor_cal_mux);
+	bool calibrated = motor_cal_loaded && motor_cal.motor_type == encoder_motor.motor_type;
+	int8_t b = exonaut_speed_byte(calibrated ? &motor_cal : NULL, wheel, speed);
+	portEXIT_CRITICAL(&motor_cal_mux);
+	return b;
+}
+
+static void motor_cal_install(const motor_cal_t *cal)
+{
+	portENTER_CRITICAL(&motor_cal_mux);
+	if (cal != NULL)
+		motor_cal = *cal;
+	motor_cal_loaded = cal != NULL;
+	portEXIT_CRITICAL(&motor_cal_mux);
+}
+
+static void motor_cal_load(void)
+{
+	Preferences prefs;
+	motor_cal_t cal;
+	if (!prefs.begin(EXONAUT_CAL_NAMESPACE, true))
+		return;
+	if (prefs.getBytesLength(EXONAUT_CAL_KEY) == sizeof(cal) && prefs.getBytes(EXONAUT_CAL_KEY, &cal, sizeof(cal)) == sizeof(cal) && exonaut_motorcal_valid(&cal))
+		motor_cal_install(&cal);
+	prefs.end();
+}
+
+static bool motor_cal_store(const motor_cal_t *cal)
+{
+	Preferences prefs;
+	if (!prefs.begin(EXONAUT_CAL_NAMESPACE, false))
+		return false;
+	bool ok = cal != NULL ? prefs.putBytes(EXONAUT_CAL_KEY, cal, sizeof(*cal)) == sizeof(*cal) : prefs.remove(EXONAUT_CAL_KEY);
+	prefs.end();
+	return ok;
+}
+
 // --- exonaut Class Method Implementations ---
 void exonaut::begin(void)
 {
@@ -66,13 +452,20 @@ void exonaut::begin(void)
 	pinMode(BUTTON_B_PIN, INPUT);
 	ets_serial.begin(115200, SERIAL_8N1, 16, 17);
 	delay(100);
-	xTaskCreatePinnedToCore(rx_task, "rx_task", 3072, NULL, 2, &rx_task_handle, 0);
+	xTaskCreatePinnedToCore(rx_task, "rx_task", EXONAUT_RX_TASK_STACK, NULL, 2, &rx_task_handle, 0);
+	if (tx_task_notify == NULL)
+	{
+		tx_queue = xQueueCreate(EXONAUT_TX_QUEUE_LEN, sizeof(tx_packet_t));
+		tx_ack_queue = xQueueCreate(EXONAUT_TX_ACK_QUEUE_LEN, sizeof(tx_packet_t));
+		xTaskCreatePinnedToCore(tx_task, "tx_task", EXONAUT_TX_TASK_STACK, NULL, 2, &tx_task_notify, 0);
+	}
 	delay(100);
 	encoder_motor_set_speed_base(0, 0);
 	delay(100);
 	reset_encoder_counter(0);
 	delay(100);
 	this->set_motor_type(1);
+	motor_cal_load();
 	delay(100);
 
 	Wire.begin();
@@ -97,9 +490,9 @@ void exonaut::set_motor_type(uint8_t motortype)
 {
 	if (motortype == 1 || motortype == 2)
 	{
-		uint8_t buf[] = {0x55, 0x55, 0x04, 55, 1, 0};
-		buf[5] = motortype;
-		ets_serial.write(buf, 6);
+		uint8_t buf[EXONAUT_SETTING_PACKET_SIZE];
+		tx_send_acked(buf, exonaut_encode_motor_type(motortype, buf, sizeof(buf)));
+		encoder_motor.motor_type = motortype;
 		switch (motortype)
 		{
 		case 1:
@@ -112,6 +505,7 @@ void exonaut::set_motor_type(uint8_t motortype)
 			encoder_motor.pulse_p_r = PULSE_COUNT;
 			break;
 		}
+		odom_configure = true;
 	}
 }
 
@@ -139,6 +533,28 @@ void exonaut::encoder_motor_set_speed(uint8_t motorid, float new_speed)
 	encoder_motor_set_speed_base(new_speed1, new_speed2);
 }
 
+void exonaut::set_motor_command_interval(uint16_t ms)
+{
+	tx_motor_interval_ms = ms;
+}
+
+void exonaut::set_wheel_geometry(float radius_mm, float track_mm)
+{
+	if (radius_mm > 0)
+		wheel_radius_mm = radius_mm;
+	if (track_mm > 0)
+		wheel_track_mm = track_mm;
+	odom_configure = true;
+}
+
+void exonaut::get_wheel_geometry(float *radius_mm, float *track_mm)
+{
+	if (radius_mm != NULL)
+		*radius_mm = wheel_radius_mm;
+	if (track_mm != NULL)
+		*track_mm = wheel_track_mm;
+}
+
 void exonaut::encoder_motor_get_speed(float items[])
 {
 	items[0] = -encoder_motor.speed_1;
@@ -147,98 +563,881 @@ void exonaut::encoder_motor_get_speed(float items[])
 
 void exonaut::stop_motor(uint8_t motorid)
 {
-	uint8_t buf[] = {0x55, 0x55, 0x05, 55, 0x02, 0x00, 0x00};
-	float temp_speed1 = -encoder_motor.speed_1; // Use temp variables for calculation
-	float temp_speed2 = -encoder_motor.speed_2;
-	temp_speed1 = temp_speed1 / 55 * 90;
-	temp_speed2 = temp_speed2 / 55 * 90;
-
-	float rps1 = (float)(-temp_speed1) / 60.0f;
-	float rps2 = (float)(-temp_speed2) / 60.0f;
-	float pps1 = rps1 * 680;
-	float pps2 = rps2 * 680;
-	buf[5] = (uint8_t)((int)round(pps1 * 0.01f));
-	buf[6] = (uint8_t)((int)round(pps2 * 0.01f));
+	uint8_t buf[EXONAUT_SPEED_PACKET_SIZE];
+	int8_t byte_1 = speed_byte(0, -encoder_motor.speed_1); // the other wheel keeps its speed
+	int8_t byte_2 = speed_byte(1, -encoder_motor.speed_2);
 	switch (motorid)
 	{
 	case 1:
 		encoder_motor.speed_1 = 0;
-		buf[5] = 0;
+		byte_1 = 0;
 		break;
 	case 2:
 		encoder_motor.speed_2 = 0;
-		buf[6] = 0;
+		byte_2 = 0;
 		break;
 	default:
 		encoder_motor.speed_1 = 0;
 		encoder_motor.speed_2 = 0;
-		buf[5] = 0;
-		buf[6] = 0;
+		byte_1 = 0;
+		byte_2 = 0;
 		break;
 	}
-	ets_serial.write(buf, 7);
+	exonaut_encode_speed(byte_1, byte_2, buf, sizeof(buf));
+	tx_send_speed(buf, ack_new_id()); // tracked and resent in acknowledged mode, never held behind a servo move
 }
 
 void exonaut::encoder_motor_set_speed_base(float new_speed1, float new_speed2)
 {
-	uint8_t buf[] = {0x55, 0x55, 0x05, 55, 0x02, 0x00, 0x00};
+	uint8_t buf[EXONAUT_SPEED_PACKET_SIZE];
 	encoder_motor.speed_1 = -new_speed1;
 	encoder_motor.speed_2 = -new_speed2;
-	// Use temporary variables for ratio conversion to avoid altering the stored speeds prematurely
-	float temp_speed1 = new_speed1 / 55.0f * 90.0f;
-	float temp_speed2 = new_speed2 / 55.0f * 90.0f;
+	exonaut_encode_speed(speed_byte(0, new_speed1), speed_byte(1, new_speed2), buf, sizeof(buf));
+	tx_send_speed(buf);
+}
+
+bool exonaut::motor_calibrate(uint8_t max_byte, bool save)
+{
+	if (max_byte < 2 || max_byte > MOTOR_CAL_MAX_POINTS)
+		return false;
+	if (!start_encoder_stream(EXONAUT_CAL_STREAM_HZ))
+		return false;
+
+	// Sweep up from standstill in each direction so the deadband is found from rest
+	ExoNaut_MotorCal sweep;
+	const float speed_per_byte = 60.0f / (EXONAUT_RPM_PER_SPEED * 6.8f); // default mapping, for encoder_motor only
+	bool ok = true;
+	for (int dir = -1; dir <= 1 && ok; dir += 2)
+	{
+		for (uint8_t b = 1; b <= max_byte; b++)
+		{
+			int8_t byte = (int8_t)(dir * b);
+			uint8_t buf[EXONAUT_SPEED_PACKET_SIZE];
+			exonaut_encode_speed(byte, byte, buf, sizeof(buf));
+			encoder_motor.speed_1 = byte * speed_per_byte;
+			encoder_motor.speed_2 = byte * speed_per_byte;
+			tx_send_speed(buf);
+			delay(EXONAUT_CAL_SETTLE_MS);
+			encoder_snapshot_t a, z;
+			get_encoder_snapshot(&a);
+			delay(EXONAUT_CAL_MEASURE_MS);
+			get_encoder_snapshot(&z);
+			uint32_t dt_us = z.timestamp_us - a.timestamp_us;
+			if (z.seq == a.seq || dt_us == 0)
+			{
+				ok = false; // no encoder frames are arriving
+				break;
+			}
+			float scale = 60.0e6f / ((float)encoder_motor.pulse_p_r * (float)dt_us);
+			sweep.addSample(0, byte, (z.count_1 - a.count_1) * scale);
+			sweep.addSample(1, byte, (z.count_2 - a.count_2) * scale);
+		}
+		stop_motor(0);
+		delay(EXONAUT_CAL_SETTLE_MS);
+	}
+	stop_encoder_stream(EXONAUT_CAL_STREAM_HZ);
+
+	motor_cal_t cal;
+	if (!ok || !sweep.fit(&cal, encoder_motor.motor_type))
+		return false;
+	motor_cal_install(&cal);
+	return !save || motor_cal_store(&cal);
+}
+
+bool exonaut::motor_calibration_get(motor_cal_t *cal)
+{
+	portENTER_CRITICAL(&motor_cal_mux);
+	bool loaded = motor_cal_loaded;
+	if (loaded)
+		*cal = motor_cal;
+	portEXIT_CRITICAL(&motor_cal_mux);
+	return loaded;
+}
+
+bool exonaut::motor_calibration_set(const motor_cal_t *cal, bool save)
+{
+	if (cal == NULL || !exonaut_motorcal_valid(cal))
+		return false;
+	motor_cal_install(cal);
+	return !save || motor_cal_store(cal);
+}
+
+void exonaut::motor_calibration_clear(bool erase)
+{
+	motor_cal_install(NULL);
+	if (erase)
+		motor_cal_store(NULL);
+}
+
+void exonaut::encoder_motor_turn(float speed, float cw_deg)
+{
+	if (speed <= 0)
+		return;
+	uint32_t timeout = (uint32_t)(fabsf(cw_deg) / speed * 2000.0f) + 1000; // twice the nominal time, plus the ramp
+	turn.waiter = xTaskGetCurrentTaskHandle();
+	// encoder_motor_turn() has always turned right for a positive angle; keep that for old sketches
+	if (encoder_turn_start(speed, -cw_deg, EXONAUT_TURN_TOLERANCE_DEG, timeout))
+	{
+		while (turn.state == EXONAUT_TURN_RUNNING)
+			ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(20)); // woken by the finish, the timeout covers a lost notification
+	}
+	turn.waiter = NULL;
+	turn_release(this);
+}
+
+// Wheel command, in set_motor_speed() units, that spins the robot at deg_s
+static float turn_wheel_speed(float deg_s)
+{
+	// wheel rpm = deg_s / 360 * 60 * track / (2 * pi * radius) = deg_s * track / (12 * radius)
+	return deg_s * wheel_track_mm / (12.0f * wheel_radius_mm) / EXONAUT_RPM_PER_SPEED;
+}
+
+static void turn_listener(const encoder_snapshot_t *snap, void *arg);
+
+// Ends the turn without blocking, so the timer task can call it too; the
+// listener, timer and stream claim are left for turn_release()
+static void turn_finish(exonaut *robot, exonaut_turn_state_t result)
+{
+	portENTER_CRITICAL(&turn_mux);
+	bool mine = turn.state == EXONAUT_TURN_RUNNING; // the listener and the timer can race to get here
+	if (mine)
+	{
+		turn.state = result;
+		turn.release_pending = true;
+	}
+	portEXIT_CRITICAL(&turn_mux);
+	if (!mine)
+		return;
+	robot->stop_motor(0);
+	TaskHandle_t waiter = turn.waiter;
+	if (waiter != NULL)
+		xTaskNotifyGive(waiter);
+	turn_callback_t cb = turn_cb;
+	if (cb != NULL)
+		cb(result, turn.turned_deg, turn_cb_arg);
+}
+
+// Lets go of what a finished turn still holds; may block, so never called from
+// the timer task
+static void turn_release(exonaut *robot)
+{
+	if (xTaskGetCurrentTaskHandle() == xTimerGetTimerDaemonTaskHandle())
+		return; // a turn callback cancelling from the timeout; the listener does it
+	portENTER_CRITICAL(&turn_mux);
+	bool mine = turn.release_pending; // only one task stops the stream
+	if (mine)
+	{
+		turn.release_pending = false;
+		turn.releasing = true;
+	}
+	portEXIT_CRITICAL(&turn_mux);
+	if (!mine)
+		return;
+	robot->remove_encoder_listener(turn_listener, robot);
+	if (turn.timer != NULL)
+		xTimerStop(turn.timer, 0);
+	if (turn.own_stream)
+	{
+		robot->stop_encoder_stream(EXONAUT_TURN_STREAM_HZ);
+		turn.own_stream = false;
+	}
+	turn.releasing = false;
+}
+
+static float wrap180(float deg)
+{
+	while (deg > 180.0f)
+		deg -= 360.0f;
+	while (deg < -180.0f)
+		deg += 360.0f;
+	return deg;
+}
+
+static void turn_listener(const encoder_snapshot_t *snap, void *arg)
+{
+	exonaut *robot = (exonaut *)arg;
+	if (turn.state != EXONAUT_TURN_RUNNING)
+	{
+		turn_release(robot); // timed out since the last frame
+		return;
+	}
+	yaw_source_t yaw_fn = turn_yaw;
+	if (!turn.have_start)
+	{
+		turn.start_1 = snap->count_1;
+		turn.start_2 = snap->count_2;
+		if (yaw_fn != NULL)
+			turn.last_yaw = yaw_fn(turn_yaw_arg);
+		turn.have_start = true;
+		return;
+	}
+	if (yaw_fn != NULL)
+	{
+		// Sum the steps so turns past 180 degrees keep counting
+		float yaw = yaw_fn(turn_yaw_arg);
+		turn.turned_deg = turn.turned_deg + wrap180(yaw - turn.last_yaw);
+		turn.last_yaw = yaw;
+	}
+	else
+	{
+		// Wheel arcs in opposite directions: angle = (s2 - s1) / track, motor 1 on the left
+		float d = (float)((snap->count_2 - turn.start_2) - (snap->count_1 - turn.start_1)) / encoder_motor.pulse_p_r;
+		turn.turned_deg = d * 360.0f * wheel_radius_mm / wheel_track_mm;
+	}
+
+	float dir = turn.target_deg > 0 ? 1.0f : -1.0f;
+	float remaining = fabsf(turn.target_deg) - dir * turn.turned_deg;
+	if (remaining <= turn.tolerance_deg)
+	{
+		turn_finish(robot, EXONAUT_TURN_DONE);
+		turn_release(robot);
+		return;
+	}
+	float rate = turn.speed;
+	if (remaining < EXONAUT_TURN_SLOW_DEG)
+	{
+		rate = turn.speed * remaining / EXONAUT_TURN_SLOW_DEG;
+		if (rate < EXONAUT_TURN_MIN_SPEED)
+			rate = turn.speed < EXONAUT_TURN_MIN_SPEED ? turn.speed : EXONAUT_TURN_MIN_SPEED;
+	}
+	float command = dir * turn_wheel_speed(rate);
+	if (fabsf(command - turn.command) >= 0.5f)
+	{
+		turn.command = command;
+		robot->set_motor_speed(-command, command);
+	}
+}
+
+static void turn_timeout(TimerHandle_t timer)
+{
+	// The claimed stream brings the listener round within a frame to release the rest
+	turn_finish((exonaut *)pvTimerGetTimerID(timer), EXONAUT_TURN_TIMEOUT);
+}
+
+bool exonaut::encoder_turn_start(float speed, float ccw_deg, float tolerance_deg, uint32_t timeout_ms)
+{
+	if (speed <= 0 || timeout_ms == 0)
+		return false;
+	encoder_turn_cancel();
+	while (turn.releasing)
+		vTaskDelay(1); // rx_task is letting the last turn go
+	if (turn.timer == NULL)
+		turn.timer = xTimerCreate("turn", pdMS_TO_TICKS(timeout_ms), pdFALSE, this, turn_timeout);
+	if (turn.timer == NULL)
+		return false;
+
+	turn.target_deg = ccw_deg;
+	turn.tolerance_deg = tolerance_deg;
+	turn.speed = speed;
+	turn.turned_deg = 0;
+	turn.have_start = false;
+	if (fabsf(ccw_deg) <= tolerance_deg)
+	{
+		turn.state = EXONAUT_TURN_DONE;
+		if (turn_cb != NULL)
+			turn_cb(EXONAUT_TURN_DONE, 0, turn_cb_arg);
+		return true;
+	}
+	// Started from the timeout's callback, the last turn could not let go of its
+	// listener and stream claim; this turn takes them over
+	portENTER_CRITICAL(&turn_mux);
+	bool held = turn.release_pending;
+	turn.release_pending = false;
+	portEXIT_CRITICAL(&turn_mux);
+	turn.state = EXONAUT_TURN_RUNNING;
+	if (!held && !add_encoder_listener(turn_listener, this))
+	{
+		turn.state = EXONAUT_TURN_IDLE;
+		return false;
+	}
+	// Claim the stream even if one is running, so its owner stopping cannot end it mid-turn
+	if (!held)
+		turn.own_stream = start_encoder_stream(EXONAUT_TURN_STREAM_HZ);
+	if (!turn.own_stream)
+	{
+		turn_finish(this, EXONAUT_TURN_CANCELLED);
+		turn_release(this);
+		return false;
+	}
+	vTimerSetTimerID(turn.timer, this);
+	xTimerChangePeriod(turn.timer, pdMS_TO_TICKS(timeout_ms), 0); // also starts it
+	turn.command = (ccw_deg > 0 ? 1.0f : -1.0f) * turn_wheel_speed(speed);
+	set_motor_speed(-turn.command, turn.command);
+	return true;
+}
 
-	float rps1 = (float)(-temp_speed1) / 60.0f;
-	float rps2 = (float)(-temp_speed2) / 60.0f;
-	float pps1 = rps1 * 680.0f;
-	float pps2 = rps2 * 680.0f;
-	buf[5] = (uint8_t)((int)round(pps1 * 0.01f));
-	buf[6] = (uint8_t)((int)round(pps2 * 0.01f));
-	ets_serial.write(buf, 7);
+exonaut_turn_state_t exonaut::encoder_turn_state(void)
+{
+	return turn.state;
+}
+
+float exonaut::encoder_turn_angle(void)
+{
+	return turn.turned_deg;
 }
 
-float exonaut::encoder_motor_turn_base(float speed, float angle)
+void exonaut::encoder_turn_cancel(void)
 {
-	float motor_speed = angle > 0 ? 0.2988f * speed : -0.2988f * speed; // Corrected typo: 0.298f to 0.2988f for symmetry
-	float time = (float)(fabs(angle)) / speed * 1000.0f;
-	encoder_motor_set_speed_base(motor_speed, -motor_speed);
-	return time;
+	turn_finish(this, EXONAUT_TURN_CANCELLED);
+	turn_release(this);
 }
 
-void exonaut::encoder_motor_turn(float speed, float angle)
+void exonaut::encoder_turn_on_done(turn_callback_t cb, void *arg)
 {
-	float time = encoder_motor_turn_base(speed, angle); // Removed redundant speed_1, angle_1
-	delay((int)time);
+	turn_cb = NULL;
+	turn_cb_arg = arg;
+	turn_cb = cb;
+}
+
+void exonaut::encoder_turn_set_yaw_source(yaw_source_t fn, void *arg)
+{
+	turn_yaw = NULL;
+	turn_yaw_arg = arg;
+	turn_yaw = fn;
 }
 
 void exonaut::reset_encoder_counter(uint8_t motorid)
 {
-	uint8_t buf[] = {0x55, 0x55, 0x03, 55, 0x03};
-	ets_serial.write(buf, 5);
-	delay(30); // Allow time for co-processor to update counts if needed before reading bases
+	request_encoder_count();
+	wait_encoder_count(EXONAUT_ENCODER_TIMEOUT_MS); // Returns as soon as the fresh counts are in
+	coproc_state_t st;
+	coproc_state.read(&st);
 	switch (motorid)
 	{
 	case 1:
-		encoder_motor.count_base_1 = encoder_motor.count_1;
+		encoder_motor.count_base_1 = st.encoder.count_1;
 		break;
 	case 2:
-		encoder_motor.count_base_2 = encoder_motor.count_2;
+		encoder_motor.count_base_2 = st.encoder.count_2;
 		break;
 	default:
-		encoder_motor.count_base_1 = encoder_motor.count_1;
-		encoder_motor.count_base_2 = encoder_motor.count_2;
+		encoder_motor.count_base_1 = st.encoder.count_1;
+		encoder_motor.count_base_2 = st.encoder.count_2;
 		break;
 	}
 }
 
 void exonaut::get_encoder_count(float items[])
 {
-	uint8_t buf[] = {0x55, 0x55, 0x03, 55, 0x03}; // This command might be to request update or just a header for reset logic
-	// encoder_motor.counter_updated = false; // This flag isn't used in this function to gate update from rx_task
-	ets_serial.write(buf, 5); // This seems to be a command to the co-processor
-	delay(30);				  // Wait for potential response to update encoder_motor.count_1/2 via rx_task
-	items[1] = (float)(encoder_motor.count_1 - encoder_motor.count_base_1) / encoder_motor.pulse_p_r;
-	items[0] = (float)(encoder_motor.count_2 - encoder_motor.count_base_2) / encoder_motor.pulse_p_r;
+	request_encoder_count();
+	wait_encoder_count(EXONAUT_ENCODER_TIMEOUT_MS); // Returns as soon as the fresh counts are in
+	read_encoder_count(items);
+}
+
+void exonaut::read_encoder_count(float items[])
+{
+	coproc_state_t st;
+	coproc_state.read(&st); // both counts from the same frame
+	items[1] = (float)(st.encoder.count_1 - encoder_motor.count_base_1) / encoder_motor.pulse_p_r;
+	items[0] = (float)(st.encoder.count_2 - encoder_motor.count_base_2) / encoder_motor.pulse_p_r;
+}
+
+void exonaut::request_encoder_count(void)
+{
+	uint8_t buf[EXONAUT_ENCODER_REQUEST_SIZE];
+	encoder_motor.counter_updated = false;
+	coproc_state_t st;
+	coproc_state.read(&st);
+	encoder_request_seq = st.encoder.seq;
+	tx_send(buf, exonaut_encode_encoder_request(buf, sizeof(buf)));
+}
+
+bool exonaut::encoder_count_ready(void)
+{
+	coproc_state_t st;
+	coproc_state.read(&st);
+	return st.encoder.seq != encoder_request_seq;
+}
+
+bool exonaut::wait_encoder_count(uint32_t timeout_ms)
+{
+	TickType_t start = xTaskGetTickCount();
+	TickType_t limit = pdMS_TO_TICKS(timeout_ms);
+	TaskHandle_t self = xTaskGetCurrentTaskHandle();
+	int slot = -1;
+	portENTER_CRITICAL(&encoder_waiter_mux);
+	for (int i = 0; i < EXONAUT_ENCODER_WAITERS && slot < 0; ++i)
+	{
+		if (encoder_waiters[i] == NULL)
+		{
+			encoder_waiters[i] = self;
+			slot = i;
+		}
+	}
+	portEXIT_CRITICAL(&encoder_waiter_mux);
+	while (!encoder_count_ready())
+	{
+		TickType_t elapsed = xTaskGetTickCount() - start;
+		if (elapsed >= limit)
+			break;
+		if (slot >= 0)
+			ulTaskNotifyTake(pdTRUE, limit - elapsed);
+		else
+			vTaskDelay(1); // every slot is taken; poll instead
+	}
+	if (slot >= 0)
+		encoder_waiters[slot] = NULL;
+	return encoder_count_ready();
+}
+
+static void encoder_stream_tick(TimerHandle_t timer)
+{
+	uint8_t buf[EXONAUT_ENCODER_REQUEST_SIZE];
+	tx_send(buf, exonaut_encode_encoder_request(buf, sizeof(buf)));
+}
+
+// Run the stream at rate_hz, or stop it when rate_hz is 0; only called by encoder_stream_update()
+static bool encoder_stream_apply(uint16_t rate_hz)
+{
+	if (rate_hz == encoder_stream_hz)
+		return true;
+	encoder_stream_hz = 0;
+	if (encoder_stream_timer != NULL)
+		xTimerStop(encoder_stream_timer, 0);
+	if (encoder_stream_remote && (rate_hz == 0 || !uart2_obj.binary))
+	{
+		uint8_t buf[EXONAUT_SETTING_PACKET_SIZE];
+		tx_send(buf, exonaut_encode_stream_rate(0, buf, sizeof(buf)));
+		encoder_stream_remote = false;
+	}
+	if (rate_hz == 0)
+		return true;
+	if (uart2_obj.binary)
+	{
+		// Firmware that speaks binary frames streams 'E' frames itself
+		uint8_t buf[EXONAUT_SETTING_PACKET_SIZE];
+		tx_send(buf, exonaut_encode_stream_rate((uint8_t)rate_hz, buf, sizeof(buf)));
+		encoder_stream_remote = true;
+		encoder_stream_hz = rate_hz;
+		return true;
+	}
+	// Otherwise send the count request from a FreeRTOS timer
+	TickType_t period = pdMS_TO_TICKS(1000 / rate_hz);
+	if (period == 0)
+		period = 1;
+	if (encoder_stream_timer == NULL)
+		encoder_stream_timer = xTimerCreate("enc_stream", period, pdTRUE, NULL, encoder_stream_tick);
+	else
+		xTimerChangePeriod(encoder_stream_timer, period, 0);
+	if (encoder_stream_timer == NULL || xTimerStart(encoder_stream_timer, 0) != pdPASS)
+		return false;
+	encoder_stream_hz = rate_hz;
+	return true;
+}
+
+// Highest rate still claimed, 0 when every user has released the stream
+static uint16_t encoder_stream_wanted(void)
+{
+	uint16_t rate = 0;
+	for (uint8_t i = 0; i < EXONAUT_STREAM_USERS; i++)
+		if (encoder_stream_claims[i] > rate)
+			rate = encoder_stream_claims[i];
+	return rate;
+}
+
+// Bring the stream to the rate currently claimed.  Callers are serialised and
+// the claims are read under the lock, so the last caller always applies the
+// newest claims, whatever order the tasks get here in.
+static bool encoder_stream_update(void)
+{
+	if (encoder_stream_lock == NULL)
+	{
+		SemaphoreHandle_t lock = xSemaphoreCreateMutex();
+		portENTER_CRITICAL(&encoder_stream_mux);
+		if (encoder_stream_lock == NULL)
+		{
+			encoder_stream_lock = lock;
+			lock = NULL;
+		}
+		portEXIT_CRITICAL(&encoder_stream_mux);
+		if (lock != NULL)
+			vSemaphoreDelete(lock); // another task created it first
+		if (encoder_stream_lock == NULL)
+			return false;
+	}
+	xSemaphoreTake(encoder_stream_lock, portMAX_DELAY);
+	portENTER_CRITICAL(&encoder_stream_mux);
+	uint16_t rate = encoder_stream_wanted();
+	portEXIT_CRITICAL(&encoder_stream_mux);
+	bool ok = encoder_stream_apply(rate);
+	xSemaphoreGive(encoder_stream_lock);
+	return ok;
+}
+
+bool exonaut::start_encoder_stream(uint16_t rate_hz)
+{
+	if (rate_hz == 0 || rate_hz > EXONAUT_STREAM_MAX_HZ)
+		return false;
+	int8_t slot = -1;
+	portENTER_CRITICAL(&encoder_stream_mux);
+	for (uint8_t i = 0; i < EXONAUT_STREAM_USERS && slot < 0; i++)
+		if (encoder_stream_claims[i] == 0)
+		{
+			encoder_stream_claims[i] = rate_hz;
+			slot = i;
+		}
+	portEXIT_CRITICAL(&encoder_stream_mux);
+	if (slot < 0)
+		return false; // every claim is taken
+	if (encoder_stream_update())
+		return true;
+	portENTER_CRITICAL(&encoder_stream_mux);
+	encoder_stream_claims[slot] = 0;
+	portEXIT_CRITICAL(&encoder_stream_mux);
+	encoder_stream_update(); // back to what the other claims want
+	return false;
+}
+
+void exonaut::stop_encoder_stream(uint16_t rate_hz)
+{
+	int8_t slot = -1;
+	portENTER_CRITICAL(&encoder_stream_mux);
+	// Release the claim made at rate_hz, or the newest one when rate_hz is 0
+	for (int8_t i = EXONAUT_STREAM_USERS - 1; i >= 0 && slot < 0; i--)
+		if (encoder_stream_claims[i] != 0 && (rate_hz == 0 || encoder_stream_claims[i] == rate_hz))
+			slot = i;
+	if (slot >= 0)
+		encoder_stream_claims[slot] = 0;
+	portEXIT_CRITICAL(&encoder_stream_mux);
+	if (slot >= 0)
+		encoder_stream_update();
+}
+
+uint16_t exonaut::encoder_stream_rate(void)
+{
+	return encoder_stream_hz;
+}
+
+uint8_t exonaut::read_encoder_history(uint32_t after_seq, encoder_snapshot_t *out, uint8_t max)
+{
+	uint32_t newest = encoder_history_seq.load(std::memory_order_acquire);
+	if ((int32_t)(newest - after_seq) <= 0)
+		return 0;
+	uint32_t first = after_seq + 1;
+	if (newest - after_seq > EXONAUT_ENCODER_HISTORY)
+		first = newest - EXONAUT_ENCODER_HISTORY + 1; // older frames have been overwritten
+	uint8_t n = 0;
+	for (uint32_t seq = first; seq != newest + 1 && n < max; ++seq)
+	{
+		const encoder_snapshot_t *slot = &encoder_history[seq & (EXONAUT_ENCODER_HISTORY - 1)];
+		if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != seq)
+			continue;
+		out[n] = *slot;
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) == seq)
+			++n; // otherwise rx_task lapped us mid-copy; skip the sample
+	}
+	return n;
+}
+
+bool exonaut::add_encoder_listener(encoder_callback_t cb, void *arg)
+{
+	bool added = false;
+	portENTER_CRITICAL(&encoder_listener_mux);
+	for (int i = 0; i < EXONAUT_ENCODER_LISTENERS && !added; ++i)
+	{
+		if (encoder_listeners[i].cb == NULL)
+		{
+			encoder_listeners[i].arg = arg;
+			encoder_listeners[i].cb = cb;
+			added = true;
+		}
+	}
+	portEXIT_CRITICAL(&encoder_listener_mux);
+	return added;
+}
+
+void exonaut::remove_encoder_listener(encoder_callback_t cb, void *arg)
+{
+	bool running = false;
+	portENTER_CRITICAL(&encoder_listener_mux);
+	for (int i = 0; i < EXONAUT_ENCODER_LISTENERS; ++i)
+	{
+		if (encoder_listeners[i].cb == cb && encoder_listeners[i].arg == arg)
+		{
+			encoder_listeners[i].cb = NULL;
+			if (encoder_dispatch_slot == i)
+				running = true;
+		}
+	}
+	uint32_t gen = encoder_dispatch_gen;
+	portEXIT_CRITICAL(&encoder_listener_mux);
+	// Once this returns the callback is not running and will not be called again,
+	// so its arg can be freed.  A listener removing itself from rx_task cannot wait.
+	if (running && xTaskGetCurrentTaskHandle() != rx_task_self)
+	{
+		while (encoder_dispatch_gen == gen)
+			vTaskDelay(1);
+	}
+}
+
+bool exonaut::enable_binary_telemetry(void)
+{
+	// Only firmware that reports EXONAUT_BIN_MIN_VERSION or later in its 'V' frame understands the request
+	if (uart2_obj.version[0] != 'V' || atoi(&uart2_obj.version[1]) < EXONAUT_BIN_MIN_VERSION)
+		return false;
+	uint8_t buf[EXONAUT_SETTING_PACKET_SIZE];
+	size_t len = exonaut_encode_telemetry_format(true, buf, sizeof(buf));
+	uint32_t seen = rx_binary_frames;
+	tx_send(buf, len);
+	for (uint32_t waited = 0; waited < EXONAUT_BIN_CONFIRM_MS; waited += 5)
+	{
+		if (rx_binary_frames != seen)
+		{
+			uart2_obj.binary = true;
+			return true;
+		}
+		delay(5);
+	}
+	disable_binary_telemetry(); // no binary frames arrived; make sure both ends stay on ASCII
+	return false;
+}
+
+void exonaut::disable_binary_telemetry(void)
+{
+	uint8_t buf[EXONAUT_SETTING_PACKET_SIZE];
+	tx_send(buf, exonaut_encode_telemetry_format(false, buf, sizeof(buf)));
+	uart2_obj.binary = false;
+}
+
+void exonaut::get_encoder_snapshot(encoder_snapshot_t *snap)
+{
+	coproc_state_t st;
+	coproc_state.read(&st);
+	*snap = st.encoder;
+}
+
+void exonaut::get_coproc_state(coproc_state_t *state)
+{
+	coproc_state.read(state);
+}
+
+void exonaut::set_ack_mode(bool enable, uint16_t timeout_ms, uint8_t retries)
+{
+	ack_timeout_ms = timeout_ms;
+	ack_retries = retries;
+	ack_mode = enable;
+}
+
+uint32_t exonaut::last_command_id(void)
+{
+	return ack_next_id;
+}
+
+uint32_t exonaut::tx_dropped_packets(void)
+{
+	return tx_overflows;
+}
+
+exonaut_cmd_status_t exonaut::command_status(uint32_t id)
+{
+	if (id == 0 || ack_slot_id[id % EXONAUT_ACK_HISTORY] != id)
+		return EXONAUT_CMD_NONE; // unknown, or too old to still be tracked
+	return (exonaut_cmd_status_t)ack_result[id % EXONAUT_ACK_HISTORY];
+}
+
+exonaut_cmd_status_t exonaut::wait_command(uint32_t id, uint32_t timeout_ms)
+{
+	TickType_t start = xTaskGetTickCount();
+	TickType_t limit = pdMS_TO_TICKS(timeout_ms);
+	TaskHandle_t self = xTaskGetCurrentTaskHandle();
+	int slot = -1;
+	portENTER_CRITICAL(&ack_waiter_mux);
+	for (int i = 0; i < EXONAUT_ACK_WAITERS && slot < 0; ++i)
+	{
+		if (ack_waiters[i] == NULL)
+		{
+			ack_waiters[i] = self;
+			slot = i;
+		}
+	}
+	portEXIT_CRITICAL(&ack_waiter_mux);
+	while (command_status(id) == EXONAUT_CMD_PENDING)
+	{
+		TickType_t elapsed = xTaskGetTickCount() - start;
+		if (elapsed >= limit)
+			break;
+		if (slot >= 0)
+			ulTaskNotifyTake(pdTRUE, limit - elapsed);
+		else
+			vTaskDelay(1); // every slot is taken; poll instead
+	}
+	if (slot >= 0)
+		ack_waiters[slot] = NULL;
+	return command_status(id);
+}
+
+void exonaut::on_command_timeout(exonaut_cmd_callback_t cb, void *arg)
+{
+	ack_timeout_arg = arg;
+	ack_timeout_cb = cb;
+}
+
+bool exonaut::ir_read_event(ir_event_t *event, uint32_t timeout_ms)
+{
+	if (ir.ir_queue == NULL)
+		return false;
+	return xQueueReceive(ir.ir_queue, event, pdMS_TO_TICKS(timeout_ms)) == pdTRUE;
+}
+
+void exonaut::ir_on_event(ir_callback_t cb, void *arg)
+{
+	ir_cb = NULL;
+	ir_cb_arg = arg;
+	ir_cb = cb;
+}
+
+void exonaut::ir_set_timing(uint16_t long_press_ms, uint16_t repeat_ms, uint16_t debounce_ms)
+{
+	rx_telem.ir.setTiming(long_press_ms, repeat_ms, debounce_ms);
+}
+
+float exonaut::get_battery_voltage(void)
+{
+	coproc_state_t st;
+	coproc_state.read(&st);
+	return st.volt;
+}
+
+void exonaut::get_battery_status(battery_status_t *status)
+{
+	coproc_state_t st;
+	coproc_state.read(&st);
+	*status = st.battery;
+}
+
+void exonaut::battery_set_filter(uint16_t time_constant_ms)
+{
+	rx_telem.battery.setFilter(time_constant_ms);
+}
+
+void exonaut::battery_set_thresholds(float warn_mv, float critical_mv)
+{
+	rx_telem.battery.setThresholds(warn_mv, critical_mv);
+}
+
+void exonaut::battery_on_warning(battery_callback_t cb, void *arg)
+{
+	battery_cb = NULL;
+	battery_cb_arg = arg;
+	battery_cb = cb;
+}
+
+float exonaut::battery_speed_limit(void)
+{
+	coproc_state_t st;
+	coproc_state.read(&st);
+	return st.battery.speed_limit;
+}
+
+bool exonaut::capture_start(size_t bytes)
+{
+	capture_on = false;
+	portENTER_CRITICAL(&capture_mux);
+	capture.end(); // detach before the buffer can move
+	portEXIT_CRITICAL(&capture_mux);
+	uint8_t *buf = (uint8_t *)realloc(capture_buf, bytes);
+	if (buf == NULL)
+		return false;
+	capture_buf = buf;
+	portENTER_CRITICAL(&capture_mux);
+	bool ok = capture.begin(capture_buf, bytes);
+	portEXIT_CRITICAL(&capture_mux);
+	capture_on = ok;
+	return ok;
+}
+
+void exonaut::capture_stop(void)
+{
+	capture_on = false;
+}
+
+size_t exonaut::capture_data(const uint8_t **data)
+{
+	portENTER_CRITICAL(&capture_mux);
+	size_t len = capture.length();
+	portEXIT_CRITICAL(&capture_mux);
+	*data = capture.data();
+	return len;
+}
+
+size_t exonaut::capture_dump(Print &out)
+{
+	const uint8_t *data;
+	size_t len = capture_data(&data);
+	return data != NULL ? out.write(data, len) : 0;
+}
+
+void exonaut::capture_free(void)
+{
+	capture_on = false;
+	portENTER_CRITICAL(&capture_mux);
+	capture.end();
+	portEXIT_CRITICAL(&capture_mux);
+	free(capture_buf);
+	capture_buf = NULL;
+}
+
+static void odom_listener(const encoder_snapshot_t *snap, void *arg)
+{
+	if (odom_configure)
+	{
+		odom_configure = false;
+		odom.setGeometry(wheel_radius_mm, wheel_track_mm, encoder_motor.pulse_p_r);
+	}
+	if (odom_reset_pending)
+	{
+		portENTER_CRITICAL(&odom_mux);
+		odom.reset(odom_reset_pose[0], odom_reset_pose[1], odom_reset_pose[2]);
+		odom_reset_pending = false;
+		portEXIT_CRITICAL(&odom_mux);
+	}
+	odom.update(snap->count_1, snap->count_2, snap->timestamp_us);
+	odom_pose_t pose;
+	odom.getPose(&pose);
+	odom_pose.write(pose);
+}
+
+bool exonaut::odometry_start(uint16_t rate_hz)
+{
+	if (odom_running)
+		return true;
+	odometry_reset(); // takes effect on the first frame, before any counts are integrated
+	if (!add_encoder_listener(odom_listener, NULL))
+		return false;
+	if (!start_encoder_stream(rate_hz))
+	{
+		remove_encoder_listener(odom_listener, NULL);
+		return false;
+	}
+	odom_stream_hz = rate_hz;
+	odom_running = true;
+	return true;
+}
+
+void exonaut::odometry_stop(void)
+{
+	if (!odom_running)
+		return;
+	remove_encoder_listener(odom_listener, NULL);
+	stop_encoder_stream(odom_stream_hz);
+	odom_stream_hz = 0;
+	odom_running = false;
+}
+
+void exonaut::odometry_reset(float x_mm, float y_mm, float heading_rad)
+{
+	portENTER_CRITICAL(&odom_mux);
+	odom_reset_pose[0] = x_mm;
+	odom_reset_pose[1] = y_mm;
+	odom_reset_pose[2] = heading_rad;
+	odom_reset_pending = true;
+	portEXIT_CRITICAL(&odom_mux);
+}
+
+void exonaut::get_pose(odom_pose_t *pose)
+{
+	odom_pose.read(pose);
 }
 
 void exonaut::setColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b)
@@ -269,168 +1468,231 @@ void exonaut::clear(void)
 void exonaut::beginBusServo()
 {
 	uint8_t buf[10] = {0x55, 0x55, 0x08, 0x03, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00};
-	ets_serial.write(buf, 10);
+	tx_send(buf, 10);
 }
 
 void exonaut::bus_servo_set_pose(uint8_t id, uint16_t pos, uint16_t time)
 {
-	uint8_t buf[10] = {0x55, 0x55, 0x08, 0x03, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00};
-	buf[5] = time & 0x00FF;
-	buf[6] = (time >> 8) & 0x00FF;
-	buf[7] = id;
-	buf[8] = pos & 0x00FF;
-	buf[9] = (pos >> 8) & 0x00FF;
-	ets_serial.write(buf, 10);
+	bus_servo_pose_t pose = {id, pos};
+	bus_servo_set_poses(&pose, 1, time, true); // tracked only while set_ack_mode() is on
+}
+
+void exonaut::bus_servo_request_state(uint8_t id)
+{
+	uint8_t buf[BUS_SERVO_READ_SIZE];
+	tx_send(buf, (uint8_t)exonaut_servo_encode_read(id, buf, sizeof(buf)));
+}
+
+bool exonaut::bus_servo_get_state(uint8_t id, bus_servo_state_t *state)
+{
+	servo_table_t table;
+	servo_table.read(&table);
+	for (int i = 0; i < BUS_SERVO_TRACKED; ++i)
+	{
+		if (table.servo[i].updates != 0 && table.servo[i].id == id)
+		{
+			*state = table.servo[i];
+			return true;
+		}
+	}
+	return false;
+}
+
+bool exonaut::bus_servo_set_poses(const bus_servo_pose_t *poses, uint8_t count, uint16_t time, bool acked)
+{
+	uint8_t buf[BUS_SERVO_PACKET_SIZE(BUS_SERVO_MAX_BATCH)];
+	size_t len = exonaut_servo_encode_move(poses, count, time, buf, sizeof(buf));
+	if (len == 0)
+		return false;
+	// One packet, so every joint starts on the same frame
+	if (acked)
+		tx_send_acked(buf, (uint8_t)len); // the reply comes when the move ends
+	else
+		tx_send(buf, (uint8_t)len);
+	return true;
 }
 
 // --- rx_task (Co-processor communication) ---
-// This task remains largely the same, ensure loop variables don't clash if modified.
-// Renamed loop variables i,j to k_idx, j_idx in case 'E' in original code was a good catch.
+#if EXONAUT_RX_EVENT_DRIVEN
+// Runs in the UART driver's event task after the RX line has been idle for
+// EXONAUT_RX_TIMEOUT_SYMBOLS, which is the end of a '$' terminated frame burst.
+static void rx_uart_receive_cb(void)
+{
+	if (rx_task_notify != NULL)
+		xTaskNotifyGive(rx_task_notify);
+}
+#endif
+
+// Battery and IR status, carried by 'A' frames in either format
+static void rx_publish_status(uint8_t flags)
+{
+	coproc_state_t *st = &rx_telem.state;
+	uart2_obj.volt = st->volt;
+	coproc_state.write(*st);
+	battery_callback_t bcb = battery_cb;
+	if ((flags & TELEM_BATTERY_LEVEL) && bcb != NULL)
+		bcb(&st->battery, battery_cb_arg);
+
+	ir.ir_key = st->ir_key;
+	for (uint8_t k = 0; k < rx_telem.ir_event_count; ++k)
+	{
+		if (ir.ir_queue != NULL)
+			xQueueSend(ir.ir_queue, &rx_telem.ir_events[k], 0);
+		ir_callback_t cb = ir_cb;
+		if (cb != NULL)
+			cb(&rx_telem.ir_events[k], ir_cb_arg);
+	}
+}
+
+static void rx_publish_encoder(void)
+{
+	const encoder_snapshot_t *enc = &rx_telem.state.encoder;
+	encoder_motor.count_1 = enc->count_1;
+	encoder_motor.count_2 = enc->count_2;
+	encoder_motor.counter_updated = true; // Set flag
+
+	encoder_snapshot_t *slot = &encoder_history[enc->seq & (EXONAUT_ENCODER_HISTORY - 1)];
+	__atomic_store_n(&slot->seq, 0, __ATOMIC_RELAXED);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot->count_1 = enc->count_1;
+	slot->count_2 = enc->count_2;
+	slot->timestamp_us = enc->timestamp_us;
+	slot->dropped = enc->dropped;
+	__atomic_store_n(&slot->seq, enc->seq, __ATOMIC_RELEASE);
+	encoder_history_seq.store(enc->seq, std::memory_order_release);
+	coproc_state.write(rx_telem.state);
+
+	for (int i = 0; i < EXONAUT_ENCODER_WAITERS; ++i)
+	{
+		TaskHandle_t waiter = encoder_waiters[i];
+		if (waiter != NULL)
+			xTaskNotifyGive(waiter);
+	}
+	for (int8_t i = 0; i < EXONAUT_ENCODER_LISTENERS; ++i)
+	{
+		// Take cb and arg together, so a listener added to the slot meanwhile cannot mix with the old one
+		portENTER_CRITICAL(&encoder_listener_mux);
+		encoder_callback_t cb = encoder_listeners[i].cb;
+		void *arg = encoder_listeners[i].arg;
+		if (cb != NULL)
+		{
+			encoder_dispatch_slot = i;
+			++encoder_dispatch_gen;
+		}
+		portEXIT_CRITICAL(&encoder_listener_mux);
+		if (cb == NULL)
+			continue;
+		cb(enc, arg);
+		portENTER_CRITICAL(&encoder_listener_mux);
+		encoder_dispatch_slot = -1;
+		++encoder_dispatch_gen;
+		portEXIT_CRITICAL(&encoder_listener_mux);
+	}
+}
+
+static void rx_apply_servo(const bus_servo_reading_t *r)
+{
+	bus_servo_state_t *slot = NULL;
+	bus_servo_state_t *oldest = &rx_servos.servo[0];
+	for (int i = 0; i < BUS_SERVO_TRACKED && slot == NULL; ++i)
+	{
+		bus_servo_state_t *s = &rx_servos.servo[i];
+		if (s->updates == 0 || s->id == r->id)
+			slot = s;
+		else if ((int32_t)(s->timestamp_us - oldest->timestamp_us) < 0)
+			oldest = s;
+	}
+	if (slot == NULL)
+	{
+		slot = oldest;
+		slot->updates = 0;
+	}
+	slot->id = r->id;
+	slot->pos = r->pos;
+	slot->volt_mv = r->volt_mv;
+	slot->temp_c = r->temp_c;
+	slot->timestamp_us = rx_stamp_us;
+	++slot->updates;
+	servo_table.write(rx_servos);
+}
+
+// Handles one frame.  The frame points into the receive ring and is only
+// valid until the framer is called again.  Decoding is done by rx_telem (see
+// ExoNaut_Telemetry.h); this publishes the result to the rest of the library.
+static void rx_handle_frame(const exonaut_frame_t *frame)
+{
+	if (frame->format == EXONAUT_FRAME_BINARY)
+		++rx_binary_frames;
+	float load = (fabsf(encoder_motor.speed_1) + fabsf(encoder_motor.speed_2)) * 0.5f; // last commanded speeds
+	uint8_t flags = rx_telem.decode(frame, rx_stamp_us, millis(), load);
+	if (flags & TELEM_STATUS)
+		rx_publish_status(flags);
+	if (flags & TELEM_ENCODER)
+		rx_publish_encoder();
+	if (flags & TELEM_SERVO)
+		rx_apply_servo(&rx_telem.servo);
+	if (flags & TELEM_ACK)
+	{
+		action_finish = true;
+		++rx_acks; // matched to a command by tx_task
+		if (tx_task_notify != NULL)
+			xTaskNotifyGive(tx_task_notify);
+	}
+	if (flags & TELEM_VERSION)
+	{
+		strncpy(uart2_obj.version, rx_telem.version, sizeof(uart2_obj.version) - 1);
+		uart2_obj.version[sizeof(uart2_obj.version) - 1] = '\0';
+		if (frame->format == EXONAUT_FRAME_ASCII)
+			uart2_obj.binary = false; // the co-processor (re)started and talks ASCII
+	}
+}
+
+// Bytes are read from the UART straight into rx_ring and framed in place;
+// rx_handle_frame() gets a view into the ring, so nothing is copied per frame.
+static ExoNaut_RingBuffer rx_ring;
+static ExoNaut_Framer rx_framer(rx_ring);
+
 void rx_task(void *pvParameter)
 {
-	static uint8_t rx_buf[64];
-	static uint8_t cmd_buf[64];
-	uint8_t loop_i = 0, index = 0; // Renamed 'i' to 'loop_i' to avoid conflict
-	int8_t rxBytes;
-	uint16_t ir_code = 0x0000;
-	uint16_t ir_count = 0;
+	int rxBytes; // int: available() can exceed 127 once several frames are queued
+	exonaut_frame_t frame;
 
+	rx_task_self = xTaskGetCurrentTaskHandle();
 	ir.ir_queue = xQueueCreate(10, sizeof(ir_event_t));
 	uart2_obj.initilized = true;
 
-	// Initial command to co-processor?
-	// rx_buf[0] = 0x55; // This was in the original, seems overwritten by the next lines
-	// rx_buf[1] = 0x55;
-	// rx_buf[2] = 0x02;
-	// rx_buf[3] = 0x12;
-	// ets_serial.write(rx_buf, 4); // If this is an init command, ensure it's correct
-
 	ets_serial.flush();
 
+#if EXONAUT_RX_EVENT_DRIVEN
+	rx_task_notify = xTaskGetCurrentTaskHandle();
+	ets_serial.setRxTimeout(EXONAUT_RX_TIMEOUT_SYMBOLS);
+	ets_serial.onReceive(rx_uart_receive_cb, true);
+#endif
+
 	for (;;)
 	{
-		rxBytes = ets_serial.available();
-		if (rxBytes > 0)
+#if EXONAUT_RX_EVENT_DRIVEN
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY); // Sleep until the UART reports a complete burst
+#endif
+		// Drain everything the driver has buffered; several frames may be waiting
+		while ((rxBytes = ets_serial.available()) > 0)
 		{
-			rxBytes = rxBytes > 63 ? 63 : rxBytes; // Cap read size
-			ets_serial.readBytes(rx_buf, rxBytes);
-			for (loop_i = 0; loop_i < rxBytes; ++loop_i)
-			{ // Use loop_i
-				if ('$' == rx_buf[loop_i])
-				{
-					uint8_t cmd = cmd_buf[0];
-					cmd_buf[index] = '\0'; // Null-terminate
-					switch (cmd)
-					{
-					case 'A':
-						if (index == 7)
-						{
-							if (uart2_obj.volt == -1)
-							{
-								uart2_obj.volt = (((float)HEX_TO_INT(cmd_buf[1], cmd_buf[2])) * 51.765f);
-							}
-							else
-							{
-								uart2_obj.volt = uart2_obj.volt * 0.99f + (((float)HEX_TO_INT(cmd_buf[1], cmd_buf[2])) * 51.765f * 0.01f);
-							}
-							ir_code = ((((uint16_t)(HEX_TO_INT(cmd_buf[5], cmd_buf[6]))) << 8) & 0xFF00) | (HEX_TO_INT(cmd_buf[3], cmd_buf[4]));
-						}
-						if (index == 3)
-						{ // Assuming this means "OK$" or similar short ack
-							action_finish = true;
-						}
-						if (ir_code != ir.ir_key)
-						{
-							if (ir_code != 0x00)
-							{
-								ir_event_t event = {.ir_code = ir_code, .event = 1};
-								if (ir.ir_queue != NULL)
-									xQueueSend(ir.ir_queue, &event, 0);
-							}
-							else
-							{
-								if (ir_count >= 30)
-								{
-									ir_event_t event = {.ir_code = ir.ir_key, .event = 5};
-									if (ir.ir_queue != NULL)
-										xQueueSend(ir.ir_queue, &event, 0);
-								}
-								else
-								{
-									ir_event_t event = {.ir_code = ir.ir_key, .event = 2};
-									if (ir.ir_queue != NULL)
-										xQueueSend(ir.ir_queue, &event, 0);
-								}
-							}
-							ir.ir_key = ir_code;
-							ir_count = 0;
-						}
-						else
-						{
-							if (ir_code != 0)
-							{
-								if (ir_count == 30)
-								{
-									ir_event_t event = {.ir_code = ir_code, .event = 4};
-									if (ir.ir_queue != NULL)
-										xQueueSend(ir.ir_queue, &event, 0);
-								}
-								++ir_count;
-								if (ir_count > 10000)
-									ir_count = 31; // Prevent overflow, keep in long press state
-							}
-							else
-							{
-								ir_count = 0;
-							}
-						}
-						break;
-					case 'V':
-						if (index == 4)
-						{												   // e.g., "V123$"
-							memcpy(uart2_obj.version, cmd_buf, index + 1); // +1 for null if cmd_buf has it
-							// uart2_obj.version[index + 1] = '\0'; // Original had index+1, ensure size of version array
-						}
-						break;
-					case 'I':
-						// if (index == 4 && cmd_buf[1] == 'R' && cmd_buf[2] == 'O' && cmd_buf[3] == 'K') { }
-						break;
-					case 'S':
-						// if (index == 5) { }
-						break;
-					case 'E':
-						if (cmd_buf[1] == 'M' && cmd_buf[2] == 'M' && index == 19)
-						{ // Example "EMM<16 hex chars>$" -> 3+16 = 19
-							union
-							{
-								uint8_t bytes[8];
-								int32_t tol[2];
-							} i32a;
-							for (int k_idx = 0, j_idx = 18; k_idx < 8; ++k_idx, j_idx -= 2)
-							{
-								i32a.bytes[k_idx] = HEX_TO_INT(cmd_buf[j_idx - 1 + (3 - 1)], cmd_buf[j_idx + (3 - 1)]); // Offset by "EMM"
-							}
-							encoder_motor.count_1 = -i32a.tol[0];
-							encoder_motor.count_2 = -i32a.tol[1];
-							encoder_motor.counter_updated = true; // Set flag
-						}
-						break;
-					default:
-						break;
-					}
-					memset(cmd_buf, 0, sizeof(cmd_buf));
-					index = 0;
-				}
-				else if (index < (sizeof(cmd_buf) - 1) && !('\n' == rx_buf[loop_i]) && !('\r' == rx_buf[loop_i]))
-				{ // Check bounds, ignore CR/LF
-					cmd_buf[index++] = rx_buf[loop_i];
-				}
-				else
-				{
-					// Ignore, or handle buffer full / unexpected char
-				}
+			uint8_t *span;
+			size_t space = rx_ring.writeSpan(&span);
+			if (space == 0)
+			{
+				rx_framer.reset(); // Only reachable with a corrupt stream; resynchronise
+				continue;
 			}
+			size_t got = ets_serial.readBytes(span, (size_t)rxBytes < space ? (size_t)rxBytes : space);
+			capture_record(EXONAUT_CAPTURE_RX, span, got);
+			rx_ring.commit(got);
+			rx_stamp_us = micros();
+			while (rx_framer.next(&frame))
+				rx_handle_frame(&frame);
 		}
-		vTaskDelay(pdMS_TO_TICKS(20)); // Use FreeRTOS delay
+#if !EXONAUT_RX_EVENT_DRIVEN
+		vTaskDelay(pdMS_TO_TICKS(EXONAUT_RX_POLL_MS)); // Use FreeRTOS delay
+#endif
 	}
-}
\ No newline at end of file
+}
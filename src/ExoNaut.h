@@ -18,8 +18,18 @@
 #include <HardwareSerial.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include <freertos/timers.h>
+#include <freertos/semphr.h>
 
 #include "ExoNautPixel.h"
+#include "ExoNaut_IREvents.h"
+#include "ExoNaut_Battery.h"
+#include "ExoNaut_Telemetry.h"
+#include "ExoNaut_Capture.h"
+#include "ExoNaut_Odometry.h"
+#include "ExoNaut_BusServo.h"
+#include "ExoNaut_MotorCal.h"
+#include "ExoNaut_Commands.h"
 
 // Port Pin Mappings
 
@@ -28,9 +38,58 @@
 #define HEX_TO_INT(high, low) ((uint8_t)((0xF0 & (((hex2int((high))) << 4))) | (0x0F & (hex2int((low))))))
 
 // Co-processor definitions
+// The UART driver wakes rx_task through onReceive() once the line goes idle after
+// a frame, instead of rx_task polling every 20ms.  Older cores fall back to polling.
+#if defined(ESP_ARDUINO_VERSION) && ESP_ARDUINO_VERSION >= ESP_ARDUINO_VERSION_VAL(2, 0, 5)
+#define EXONAUT_RX_EVENT_DRIVEN 1
+#else
+#define EXONAUT_RX_EVENT_DRIVEN 0
+#endif
+#define EXONAUT_RX_TIMEOUT_SYMBOLS 2 // idle symbols (~170us at 115200) that end a frame burst
+#define EXONAUT_RX_POLL_MS 20		 // poll interval when EXONAUT_RX_EVENT_DRIVEN is 0
+
+// Binary telemetry (frame layout in ExoNaut_Framer.h).  Requested with
+// {0x55, 0x55, 0x04, 55, 0x10, mode}, mode 1 = binary, 0 = ASCII.  Payloads:
+//   'A'  volt(u8) ir_code(u16 LE), or empty for an action-finished ack
+//   'E'  seq(u8) count_1(i32 LE) count_2(i32 LE), raw co-processor counts
+//   'V'  version text, same as the ASCII 'V' frame
+//   'S'  bus servo state, see ExoNaut_BusServo.h; provisional, no released firmware sends it yet
+#define EXONAUT_BIN_MIN_VERSION 200 // first co-processor firmware ("V200") that can send binary frames
+#define EXONAUT_BIN_CONFIRM_MS 200	// time allowed for the first binary frame after the request
+
+// Outgoing packets are handed to tx_task so callers never wait on the UART.
+// Motor speed packets are coalesced: only the newest one is sent, and no more
+// often than the motor command interval.
+#define EXONAUT_TX_PACKET_MAX 32		  // longest packet tx_task accepts
+#define EXONAUT_TX_QUEUE_LEN 16			  // packets that can wait for tx_task
+#define EXONAUT_TX_ACK_QUEUE_LEN 8		  // acknowledged commands that can wait for tx_task
+#define EXONAUT_MOTOR_INTERVAL_MS 10	  // default minimum time between motor speed packets
+
+// Acknowledged mode: set_motor_type, stop_motor, bus_servo_set_pose and servo
+// batches sent with acked = true wait for the co-processor's action-finished
+// reply and are resent if it does not arrive.  A servo move is only confirmed
+// when it ends, so its timeout starts after the move time.  Replies carry no id; each is matched to
+// the command whose reply was due first (see ExoNaut_AckTracker.h).  Other
+// packets, encoder requests included, never wait behind an outstanding command,
+// and neither does a stop.  A stop that a newer speed packet overtakes is not
+// resent and is reported as EXONAUT_CMD_REPLACED.
+#define EXONAUT_ACK_TIMEOUT_MS 50 // default time to wait for the reply before resending
+#define EXONAUT_ACK_RETRIES 2	  // default resends before the command is reported as timed out
+#define EXONAUT_ACK_HISTORY 16	  // recent command results kept for command_status()
+#define EXONAUT_ACK_WAITERS 4	  // tasks woken by wait_command(); more poll every tick
 
 // encoder definitions
 #define PULSE_COUNT 1120 // encoder pulses per revolution of output shaft
+#define EXONAUT_RPM_PER_SPEED (90.0f / 55.0f) // output shaft rpm per unit of set_motor_speed()
+#define EXONAUT_WHEEL_RADIUS_MM 32.5f		  // default wheel radius
+#define EXONAUT_WHEEL_TRACK_MM 190.0f		  // default distance between the wheel contact points
+
+// Motor calibration (see ExoNaut_MotorCal.h), kept in NVS across resets
+#define EXONAUT_CAL_NAMESPACE "exonaut"
+#define EXONAUT_CAL_KEY "motor_cal"
+#define EXONAUT_CAL_SETTLE_MS 400  // time each speed step gets before it is measured
+#define EXONAUT_CAL_MEASURE_MS 500 // time each speed step is measured over
+#define EXONAUT_CAL_STREAM_HZ 50   // encoder rate claimed while calibrating; a faster stream keeps its rate
 
 // On board Neo Pixel definitions
 #define NEO_PIXEL_PIN 23
@@ -63,6 +122,7 @@ typedef struct __uart_obj_t
 	bool initilized;
 	float volt;
 	char version[8];
+	bool binary; // co-processor is sending binary telemetry
 } uart2_obj_t;
 
 typedef struct __ir_obj_t
@@ -71,12 +131,6 @@ typedef struct __ir_obj_t
 	QueueHandle_t ir_queue;
 } ir_obj_t;
 
-typedef struct __ir_event_t
-{
-	uint16_t ir_code;
-	int8_t event;
-} ir_event_t;
-
 typedef struct __encoder_motor_obj_t
 {
 	float pulse_p_r;
@@ -90,6 +144,81 @@ typedef struct __encoder_motor_obj_t
 	int32_t count_base_2;
 } encoder_motor_obj_t;
 
+typedef enum
+{
+	EXONAUT_CMD_NONE = 0, // unknown id, or too old to still be tracked
+	EXONAUT_CMD_PENDING,  // sent or queued, no reply yet
+	EXONAUT_CMD_DONE,	  // co-processor confirmed it
+	EXONAUT_CMD_TIMEOUT,  // no reply after every retry
+	EXONAUT_CMD_REPLACED, // a stop overtaken by a newer speed packet before its reply
+} exonaut_cmd_status_t;
+
+// Called from tx_task when an acknowledged command runs out of retries.  It
+// runs on tx_task's EXONAUT_TX_TASK_STACK and holds up every packet behind it,
+// so it must return quickly, never block and keep its locals small.
+typedef void (*exonaut_cmd_callback_t)(uint32_t id, void *arg);
+
+// tx_task writes the packets and tracks the acks.  About 1 KB goes to the task
+// and the UART driver; the rest is left for the on_command_timeout() callback.
+#define EXONAUT_TX_TASK_STACK 3072
+
+// rx_task decodes the co-processor replies and runs every encoder listener, IR,
+// battery, servo and turn callback on its own stack.  About 1.5 KB goes to the
+// decoder and the odometry and turn listeners; the rest is left for callbacks,
+// so keep their locals small (no large arrays, no printf of floats).
+#define EXONAUT_RX_TASK_STACK 4096
+
+// Called from rx_task for every IR event; must return quickly and never block
+typedef void (*ir_callback_t)(const ir_event_t *event, void *arg);
+
+// Called from rx_task when the battery level changes; must return quickly
+typedef void (*battery_callback_t)(const battery_status_t *status, void *arg);
+
+// Called from rx_task for every encoder frame; must return quickly and never block
+typedef void (*encoder_callback_t)(const encoder_snapshot_t *snap, void *arg);
+#define EXONAUT_ENCODER_LISTENERS 4 // callbacks that can be registered at once
+#define EXONAUT_ENCODER_WAITERS 4	// tasks woken by wait_encoder_count(); more poll every tick
+#define EXONAUT_ENCODER_TIMEOUT_MS 30 // reply time allowed by the blocking encoder calls
+#define EXONAUT_ENCODER_HISTORY 32	  // encoder frames kept for read_encoder_history(), power of two
+#define EXONAUT_STREAM_MAX_HZ 200	  // fastest encoder stream start_encoder_stream() accepts
+#define EXONAUT_STREAM_USERS 8		  // start_encoder_stream() calls that can be outstanding at once
+
+// Bus servo readback; the latest reply from each servo is kept
+#define BUS_SERVO_TRACKED 8 // servos remembered at once, the oldest reply is replaced
+
+typedef struct __bus_servo_state_t
+{
+	uint8_t id;
+	uint16_t pos;
+	uint16_t volt_mv;
+	uint8_t temp_c;
+	uint32_t timestamp_us; // micros() when the reply was read from the UART
+	uint32_t updates;	   // replies received from this servo
+} bus_servo_state_t;
+
+// Encoder turns
+typedef enum
+{
+	EXONAUT_TURN_IDLE = 0,	 // no turn started yet
+	EXONAUT_TURN_RUNNING,	 // wheels moving
+	EXONAUT_TURN_DONE,		 // within tolerance of the requested angle
+	EXONAUT_TURN_TIMEOUT,	 // stopped short when the timeout ran out
+	EXONAUT_TURN_CANCELLED, // stopped by encoder_turn_cancel() or a new turn
+} exonaut_turn_state_t;
+
+// Called once when a turn ends, from rx_task or the timer task; must return quickly
+typedef void (*turn_callback_t)(exonaut_turn_state_t state, float turned_deg, void *arg);
+// Optional heading source, degrees increasing as the robot turns left (counter-clockwise); must return quickly
+typedef float (*yaw_source_t)(void *arg);
+
+#define EXONAUT_TURN_TOLERANCE_DEG 2.0f // default accuracy of encoder_turn_start()
+#define EXONAUT_TURN_TIMEOUT_MS 5000	// default time allowed for a turn
+#define EXONAUT_TURN_STREAM_HZ 100		// encoder rate claimed while turning; a faster stream keeps its rate
+#define EXONAUT_TURN_SLOW_DEG 30.0f		// the speed ramps down over the last part of the turn
+#define EXONAUT_TURN_MIN_SPEED 25.0f	// slowest turn rate in deg/s, still enough to overcome friction
+
+#define EXONAUT_ODOM_RATE_HZ 50 // encoder rate claimed by odometry_start(); a faster stream keeps its rate
+
 class exonaut
 {
 public:
@@ -99,12 +228,86 @@ public:
 	void set_motor_type(uint8_t motortype);							// set encoder motor type //this is the hw_encoder_motor_set_motor_type function
 	void encoder_motor_set_speed(uint8_t motorid, float new_speed); // set speed //this is the hw_encoder_motor_set_speed function
 	void encoder_motor_get_speed(float items[]);					// get speed of both motors
-	void stop_motor(uint8_t motorid);								// stop the motorid's encoder motor
-	void encoder_motor_turn(float speed, float angle);				// rotate angle in degrees per second
+	void stop_motor(uint8_t motorid);								// stop the motorid's encoder motor; confirmed and resent in acknowledged mode
+	void encoder_motor_turn(float speed, float cw_deg);				// rotate cw_deg degrees clockwise (positive turns RIGHT) at speed degrees per second; blocks until done
+	void set_motor_command_interval(uint16_t ms);					// minimum time between speed packets sent to the co-processor
+	void set_wheel_geometry(float radius_mm, float track_mm);		// used to convert wheel turns to distance
+	void get_wheel_geometry(float *radius_mm, float *track_mm);
+
+	// Motor calibration; lift the wheels off the ground before motor_calibrate()
+	bool motor_calibrate(uint8_t max_byte = MOTOR_CAL_SWEEP_MAX, bool save = true); // sweep both wheels and use the fit from now on; blocks about 35s
+	bool motor_calibration_get(motor_cal_t *cal);				  // false while the default speed mapping is in use
+	bool motor_calibration_set(const motor_cal_t *cal, bool save = false);
+	void motor_calibration_clear(bool erase = true);			  // back to the default mapping, erase also forgets the stored fit
 
 	// Encoder Control
 	void reset_encoder_counter(uint8_t motorid); // Reset the encoder count value of motorid's encoder motor (ie set to 0)
 	void get_encoder_count(float items[]);		 // Get the encoder count value (ie the number of turns)
+	void get_encoder_snapshot(encoder_snapshot_t *snap); // Latest raw counts with arrival time and sequence number
+	void get_coproc_state(coproc_state_t *state);		 // Counts, battery and IR key from the same instant, lock-free
+
+	// Non-blocking encoder reads: request, then poll, wait or get called back
+	void request_encoder_count(void);						  // Ask the co-processor for fresh counts and return immediately
+	bool encoder_count_ready(void);							  // True once counts newer than the last request have arrived
+	bool wait_encoder_count(uint32_t timeout_ms);			  // Block the calling task (no busy wait) until they arrive; several tasks may wait
+	void read_encoder_count(float items[]);					  // Latest counts in turns, same layout as get_encoder_count
+	bool add_encoder_listener(encoder_callback_t cb, void *arg); // Call cb from rx_task on every encoder frame
+	void remove_encoder_listener(encoder_callback_t cb, void *arg); // Returns once cb is no longer running (except when called from cb itself)
+
+	// Encoder streaming: counts arrive at a fixed rate and are kept in a history buffer.
+	// Every start is a claim that one stop releases; the stream runs at the highest
+	// rate still claimed and stops when the last claim is released.
+	bool start_encoder_stream(uint16_t rate_hz); // 1 to EXONAUT_STREAM_MAX_HZ
+	void stop_encoder_stream(uint16_t rate_hz = 0); // pass the rate given to start; 0 releases the newest claim
+	uint16_t encoder_stream_rate(void); // 0 when no stream is running
+	uint8_t read_encoder_history(uint32_t after_seq, encoder_snapshot_t *out, uint8_t max); // frames with seq > after_seq, oldest first
+
+	// Non-blocking turn on the spot, closed on the encoder counts (or on yaw_source).
+	// Angles here are counter-clockwise, positive turning LEFT like Motion and the
+	// odometry; encoder_motor_turn() keeps its old clockwise sign, so
+	// encoder_motor_turn(s, 90) is encoder_turn_start(s, -90) and a wait.
+	bool encoder_turn_start(float speed, float ccw_deg, float tolerance_deg = EXONAUT_TURN_TOLERANCE_DEG, uint32_t timeout_ms = EXONAUT_TURN_TIMEOUT_MS); // speed in deg/s
+	exonaut_turn_state_t encoder_turn_state(void);
+	float encoder_turn_angle(void); // degrees turned so far, counter-clockwise
+	void encoder_turn_cancel(void);
+	void encoder_turn_on_done(turn_callback_t cb, void *arg);
+	void encoder_turn_set_yaw_source(yaw_source_t fn, void *arg); // NULL to use the encoders
+
+	// Odometry (see ExoNaut_Odometry.h); x forwards from the start, heading counter-clockwise
+	bool odometry_start(uint16_t rate_hz = EXONAUT_ODOM_RATE_HZ); // integrate every encoder frame from now on
+	void odometry_stop(void);
+	void odometry_reset(float x_mm = 0, float y_mm = 0, float heading_rad = 0);
+	void get_pose(odom_pose_t *pose); // latest pose and covariance, lock-free
+
+	// Co-processor link
+	void set_ack_mode(bool enable, uint16_t timeout_ms = EXONAUT_ACK_TIMEOUT_MS, uint8_t retries = EXONAUT_ACK_RETRIES);
+	uint32_t last_command_id(void);									   // id of the newest acknowledged command
+	exonaut_cmd_status_t command_status(uint32_t id);				   // check without blocking
+	exonaut_cmd_status_t wait_command(uint32_t id, uint32_t timeout_ms); // block until confirmed or timed out; several tasks may wait
+	void on_command_timeout(exonaut_cmd_callback_t cb, void *arg);		   // cb runs in tx_task, see exonaut_cmd_callback_t
+	uint32_t tx_dropped_packets(void);	 // packets lost because tx_task's queue was full
+	bool enable_binary_telemetry(void);	 // switch telemetry to binary frames if the co-processor supports it
+	void disable_binary_telemetry(void); // back to the ASCII telemetry
+
+	// IR remote (event codes IR_EVENT_* in ExoNaut_IREvents.h)
+	bool ir_read_event(ir_event_t *event, uint32_t timeout_ms = 0);			   // Next queued event; false if none arrived in time
+	void ir_on_event(ir_callback_t cb, void *arg);							   // Also deliver every event to cb, NULL to stop
+	void ir_set_timing(uint16_t long_press_ms, uint16_t repeat_ms, uint16_t debounce_ms = IR_DEBOUNCE_MS); // repeat_ms 0 = no auto-repeat
+
+	// Battery (see ExoNaut_Battery.h)
+	float get_battery_voltage(void);							   // Filtered pack voltage in mV, -1 before the first reading
+	void get_battery_status(battery_status_t *status);			   // Voltage, sag model and warning level
+	void battery_set_filter(uint16_t time_constant_ms);			   // 0 for no filtering
+	void battery_set_thresholds(float warn_mv, float critical_mv);
+	void battery_on_warning(battery_callback_t cb, void *arg);	   // Called whenever the warning level changes
+	float battery_speed_limit(void);							   // Highest speed expected to keep the pack above critical
+
+	// Link capture (see ExoNaut_Capture.h)
+	bool capture_start(size_t bytes = EXONAUT_CAPTURE_DEFAULT_SIZE); // Allocate a log and record all UART traffic
+	void capture_stop(void);										 // Stop recording, the log is kept
+	size_t capture_data(const uint8_t **data);						 // The log so far, returns its length
+	size_t capture_dump(Print &out);								 // Write the raw log, e.g. to Serial or a file
+	void capture_free(void);
 
 	// LED control
 	void setColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b);
@@ -114,11 +317,13 @@ public:
 
 	// bus servos
 	void beginBusServo();
-	void bus_servo_set_pose(uint8_t id, uint16_t pos, uint16_t time);
+	void bus_servo_set_pose(uint8_t id, uint16_t pos, uint16_t time); // confirmed and resent in acknowledged mode
+	void bus_servo_request_state(uint8_t id);					   // Ask a servo for position, voltage and temperature; returns at once (provisional, needs firmware that sends 'S')
+	bool bus_servo_get_state(uint8_t id, bus_servo_state_t *state); // Latest reply, false if the servo has not answered yet
+	bool bus_servo_set_poses(const bus_servo_pose_t *poses, uint8_t count, uint16_t time, bool acked = false); // up to BUS_SERVO_MAX_BATCH servos start together; acked = true to confirm the move
 
 private:
 	TaskHandle_t rx_task_handle;
-	float encoder_motor_turn_base(float speed, float angle);
 	void encoder_motor_set_speed_base(float new_speed1, float new_speed2); // this is the hw_encoder_motor_set_speed_base function
 };
 
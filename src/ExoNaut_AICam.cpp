@@ -5,11 +5,24 @@ void ExoNaut_AICam::begin(void)
     this->wire = Wire;
     // Wire.begin() is already called in the main sketch
     // with specific pins for ESP32
+    // The bus lock and the stop signal exist before any task can share the camera
+    if (_bus == NULL)
+    {
+        _bus = xSemaphoreCreateMutex();
+    }
+    if (_stopped == NULL)
+    {
+        _stopped = xSemaphoreCreateBinary();
+    }
 }
 
 int ExoNaut_AICam::readFromAddr(uint16_t addr, uint8_t *buf, uint16_t leng)
 {
     int len = 0;
+    if (_bus != NULL)
+    {
+        xSemaphoreTake(_bus, portMAX_DELAY);
+    }
     Wire.beginTransmission(CAM_DEFAULT_I2C_ADDRESS);
     Wire.write(byte(addr & 0x00FFu));
     Wire.write(byte((addr >> 8) & 0x00FFu));
@@ -35,16 +48,28 @@ int ExoNaut_AICam::readFromAddr(uint16_t addr, uint8_t *buf, uint16_t leng)
             ++len;
         }
     }
+    if (_bus != NULL)
+    {
+        xSemaphoreGive(_bus);
+    }
     return len;
 }
 
 int ExoNaut_AICam::writeToAddr(uint16_t addr, const uint8_t *buf, uint16_t leng)
 {
+    if (_bus != NULL)
+    {
+        xSemaphoreTake(_bus, portMAX_DELAY);
+    }
     Wire.beginTransmission(CAM_DEFAULT_I2C_ADDRESS);
     Wire.write(byte(addr & 0x00FFu));
     Wire.write(byte((addr >> 8) & 0x00FFu));
     Wire.write(buf, leng);
     Wire.endTransmission();
+    if (_bus != NULL)
+    {
+        xSemaphoreGive(_bus);
+    }
     return leng;
 }
 
@@ -796,63 +821,83 @@ float ExoNaut_AICam::numberProbOfId(uint8_t id)
 // Update results
 bool ExoNaut_AICam::updateResult(void)
 {
+    if (_task != NULL)
+    {
+        // The camera task has already read it; just take the latest copy
+        aicam_frame_t f;
+        _frames.read(&f);
+        if (f.frame == 0)
+        {
+            return false;
+        }
+        current = f.current;
+        memcpy(result_summ, f.summ, sizeof(result_summ));
+        return true;
+    }
     readFromAddr(0x0035, &current, 1);
-    switch (current)
+    readSummary(current, result_summ);
+    return true;
+}
+
+// Read the result summary of application func into buf
+void ExoNaut_AICam::readSummary(uint8_t func, uint8_t *buf)
+{
+    switch (func)
     {
     case APPLICATION_FACEDETECT:
     {
-        readFromAddr(0x0400, result_summ, 48);
+        readFromAddr(0x0400, buf, 48);
         break;
     };
     case APPLICATION_OBJDETECT:
     {
-        readFromAddr(0x0800, result_summ, 48);
+        readFromAddr(0x0800, buf, 48);
         break;
     }
     case APPLICATION_CLASSIFICATION:
     {
-        readFromAddr(0x0C00, result_summ, 128);
+        readFromAddr(0x0C00, buf, 128);
         break;
     }
     case APPLICATION_NUMBER_REC:
     {
-        readFromAddr(0x0D00, result_summ, 128);
+        readFromAddr(0x0D00, buf, 128);
         break;
     }
     case APPLICATION_LANDMARK:
     {
         // Updated to read from the correct address for landmarks
-        readFromAddr(0x0D80, result_summ, 48);
+        readFromAddr(0x0D80, buf, 48);
         break;
     }
     case APPLICATION_FEATURELEARNING:
     {
-        readFromAddr(0x0E00, result_summ, 64);
+        readFromAddr(0x0E00, buf, 64);
         break;
     }
     case APPLICATION_COLORDETECT:
     {
-        readFromAddr(0x1000, result_summ, 48);
+        readFromAddr(0x1000, buf, 48);
         break;
     }
     case APPLICATION_LINEFOLLOW:
     {
-        readFromAddr(0x1400, result_summ, 48);
+        readFromAddr(0x1400, buf, 48);
         break;
     }
     case APPLICATION_APRILTAG:
     {
-        readFromAddr(0x1E00, result_summ, 48);
+        readFromAddr(0x1E00, buf, 48);
         break;
     }
     case APPLICATION_QRCODE:
     {
-        readFromAddr(0x1800, result_summ, 48);
+        readFromAddr(0x1800, buf, 48);
         break;
     }
     case APPLICATION_BARCODE:
     {
-        readFromAddr(0x1C00, result_summ, 48);
+        readFromAddr(0x1C00, buf, 48);
         break;
     }
     default:
@@ -860,9 +905,92 @@ bool ExoNaut_AICam::updateResult(void)
         break;
     }
     }
+}
+
+/* -------------------------------
+   Asynchronous mode
+   ------------------------------- */
+
+bool ExoNaut_AICam::beginAsync(uint16_t interval_ms)
+{
+    if (_task != NULL)
+    {
+        return false;
+    }
+    if (_bus == NULL || _stopped == NULL)
+    {
+        return false; // begin() was not called, or ran out of memory
+    }
+    _interval = interval_ms > 0 ? interval_ms : 1;
+    _stopping = false;
+    if (xTaskCreatePinnedToCore(taskEntry, "aicam", AICAM_TASK_STACK, this, 2, &_task, 0) != pdPASS)
+    {
+        _task = NULL;
+        return false;
+    }
     return true;
 }
 
+void ExoNaut_AICam::endAsync(void)
+{
+    if (_task == NULL)
+    {
+        return;
+    }
+    _stopping = true;
+    xTaskNotifyGive(_task);
+    xSemaphoreTake(_stopped, portMAX_DELAY); // given by the task on its way out
+    _task = NULL;
+}
+
+uint32_t ExoNaut_AICam::frameCount(void) const
+{
+    aicam_frame_t f;
+    _frames.read(&f);
+    return f.frame;
+}
+
+void ExoNaut_AICam::getFrame(aicam_frame_t *frame)
+{
+    _frames.read(frame);
+}
+
+void ExoNaut_AICam::taskEntry(void *arg)
+{
+    ((ExoNaut_AICam *)arg)->run();
+}
+
+void ExoNaut_AICam::run(void)
+{
+    // Reads go into a private buffer and are published whole, so a reader
+    // never sees half of one summary and half of the next
+    aicam_frame_t back;
+    _frames.read(&back);
+    TickType_t last = xTaskGetTickCount();
+    while (!_stopping)
+    {
+        readFromAddr(0x0035, &back.current, 1);
+        readSummary(back.current, back.summ);
+        back.frame++;
+        back.timestamp_ms = millis();
+        _frames.write(back);
+        // Sleep out the interval, or until endAsync() wakes us
+        TickType_t next = last + pdMS_TO_TICKS(_interval);
+        TickType_t now = xTaskGetTickCount();
+        if ((int32_t)(next - now) > 0)
+        {
+            ulTaskNotifyTake(pdTRUE, next - now);
+            last = next;
+        }
+        else
+        {
+            last = now; // the transfer overran the interval
+        }
+    }
+    xSemaphoreGive(_stopped);
+    vTaskDelete(NULL);
+}
+
 /* -------------------------------
    New AprilTag helper functions
    ------------------------------- */
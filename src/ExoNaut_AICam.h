@@ -3,8 +3,21 @@
 
 #include <Arduino.h>
 #include <Wire.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include "ExoNaut_SeqLock.h"
 
 #define CAM_DEFAULT_I2C_ADDRESS (0x32)
+
+// Asynchronous mode: a task on core 0 polls the camera and publishes each
+// result summary, so updateResult() copies the latest one without using the bus
+// The detail getters (positions, tags, landmarks) still read the camera
+// directly, so in this mode they can describe a newer frame than the summary
+// updateResult() returned
+#define AICAM_POLL_MS 30        // default time between camera polls
+#define AICAM_TASK_STACK 3072
+#define AICAM_SUMMARY_SIZE 128
 #pragma pack(1)
 struct WonderCamQrCodeResultSumm
 {
@@ -74,6 +87,15 @@ struct WonderCamLandmarkResult
 
 #pragma pack()
 
+// Result summary published by the camera task
+typedef struct __aicam_frame_t
+{
+    uint32_t frame;        // increments by one for every summary read, 0 before the first
+    uint32_t timestamp_ms; // millis() when the read finished
+    uint8_t current;       // application running on the camera
+    uint8_t summ[AICAM_SUMMARY_SIZE];
+} aicam_frame_t;
+
 #define WONDERCAM_LED_ON (true)
 #define WONDERCAM_LED_OFF (false)
 
@@ -121,8 +143,13 @@ typedef enum
 class ExoNaut_AICam
 {
 public:
-    ExoNaut_AICam() : wire(Wire) {};
+    ExoNaut_AICam() : current(0), wire(Wire), _bus(NULL), _stopped(NULL), _task(NULL), _stopping(false), _interval(AICAM_POLL_MS) {};
     void begin(void);
+    bool beginAsync(uint16_t interval_ms = AICAM_POLL_MS); // poll from a background task from now on; needs begin()
+    void endAsync(void);
+    bool asyncRunning(void) const { return _task != NULL; }
+    uint32_t frameCount(void) const;     // summaries published by the camera task
+    void getFrame(aicam_frame_t *frame); // latest published summary, lock-free
     bool firmwareVersion(char *str);
     bool hardwareVersion(char *str);
     bool protocalVersion(char *str);
@@ -217,10 +244,20 @@ public:
     float numberProbOfId(uint8_t id);
     //
     uint8_t current;
-    uint8_t result_summ[128];
+    uint8_t result_summ[AICAM_SUMMARY_SIZE];
 
 private:
+    static void taskEntry(void *arg);
+    void run(void);
+    void readSummary(uint8_t func, uint8_t *buf);
+
     TwoWire &wire;
+    SemaphoreHandle_t _bus;     // held for each transfer, created by begin()
+    SemaphoreHandle_t _stopped; // given by the camera task as it exits
+    TaskHandle_t _task;
+    volatile bool _stopping;
+    uint16_t _interval;
+    ExoNaut_SeqLock<aicam_frame_t> _frames;
 };
 
 #endif
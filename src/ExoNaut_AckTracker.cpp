@@ -0,0 +1,232 @@
+/*
+ * ExoNaut_AckTracker.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * Implementation of the co-processor ack matching.
+ */
+
+#include "ExoNaut_AckTracker.h"
+#include "ExoNaut_BusServo.h"
+#include <string.h>
+
+#define ACK_TRACK_TIMEOUT_MS 50 // defaults, the exonaut class sets its own
+#define ACK_TRACK_RETRIES 2
+
+int32_t exonaut_ack_delay(const uint8_t *pkt, uint8_t len)
+{
+    if (len < 5 || pkt[0] != 0x55 || pkt[1] != 0x55)
+    {
+        return -1;
+    }
+    if (pkt[3] == 55 && ((pkt[4] == 0x01 && len == 6) || (pkt[4] == 0x02 && len == 7)))
+    {
+        return 0; // motor type or wheel speeds, acked as soon as applied
+    }
+    if (pkt[3] == BUS_SERVO_CMD_MOVE && len >= BUS_SERVO_PACKET_SIZE(1) && len == BUS_SERVO_PACKET_SIZE(pkt[4]))
+    {
+        return pkt[5] | (pkt[6] << 8); // acked when the move ends
+    }
+    return -1;
+}
+
+static bool is_speed_packet(const uint8_t *pkt, uint8_t len)
+{
+    return len == 7 && pkt[3] == 55 && pkt[4] == 0x02;
+}
+
+// a is earlier than b, allowing for the millisecond clock wrapping
+static bool before(uint32_t a, uint32_t b)
+{
+    return (int32_t)(a - b) < 0;
+}
+
+ExoNaut_AckTracker::ExoNaut_AckTracker() : unmatched(0), timeout_ms(ACK_TRACK_TIMEOUT_MS), retries(ACK_TRACK_RETRIES), done_count(0)
+{
+    memset(expect, 0, sizeof(expect));
+}
+
+void ExoNaut_AckTracker::setTimeout(uint16_t timeout_ms, uint8_t retries)
+{
+    this->timeout_ms = timeout_ms;
+    this->retries = retries;
+}
+
+ExoNaut_AckTracker::expect_t *ExoNaut_AckTracker::add(void)
+{
+    expect_t *oldest = NULL;
+    for (int i = 0; i < ACK_TRACK_EXPECTED; ++i)
+    {
+        expect_t *e = &expect[i];
+        if (!e->used)
+        {
+            return e;
+        }
+        if (e->id == 0 && (oldest == NULL || before(e->due_ms, oldest->due_ms)))
+        {
+            oldest = e;
+        }
+    }
+    return oldest; // write off the oldest untracked ack, NULL if every slot is tracked
+}
+
+void ExoNaut_AckTracker::sent(const uint8_t *pkt, uint8_t len, uint32_t id, uint32_t now_ms)
+{
+    int32_t delay = exonaut_ack_delay(pkt, len);
+    ack_event_t ev = {ACK_EVENT_DONE, id, NULL, 0};
+    if (delay < 0)
+    {
+        // Never acked, so there is nothing to wait for
+        if (id != 0 && done_count < ACK_TRACK_EXPECTED)
+        {
+            done[done_count++] = ev;
+        }
+        return;
+    }
+    bool speed = is_speed_packet(pkt, len);
+    if (speed)
+    {
+        // The wheels now follow the newer packet; an older tracked one must not be resent over it
+        for (int i = 0; i < ACK_TRACK_EXPECTED; ++i)
+        {
+            expect_t *e = &expect[i];
+            if (e->used && e->speed && e->id != 0)
+            {
+                ev.type = ACK_EVENT_REPLACED;
+                ev.id = e->id;
+                if (done_count < ACK_TRACK_EXPECTED)
+                {
+                    done[done_count++] = ev;
+                }
+                e->id = 0; // its ack is still expected
+            }
+        }
+    }
+    expect_t *e = add();
+    if (e == NULL || len > ACK_TRACK_PACKET_MAX)
+    {
+        if (id != 0 && done_count < ACK_TRACK_EXPECTED)
+        {
+            ev.type = ACK_EVENT_TIMEOUT;
+            ev.id = id;
+            done[done_count++] = ev;
+        }
+        return;
+    }
+    e->used = true;
+    e->speed = speed;
+    e->id = id;
+    e->due_ms = now_ms + (uint32_t)delay;
+    e->expires_ms = e->due_ms + timeout_ms;
+    e->retries = retries;
+    e->len = len;
+    if (id != 0)
+    {
+        memcpy(e->data, pkt, len);
+    }
+}
+
+void ExoNaut_AckTracker::acked(uint32_t now_ms)
+{
+    expect_t *first = NULL;
+    for (int i = 0; i < ACK_TRACK_EXPECTED; ++i)
+    {
+        expect_t *e = &expect[i];
+        if (e->used && (first == NULL || before(e->due_ms, first->due_ms)))
+        {
+            first = e;
+        }
+    }
+    if (first == NULL)
+    {
+        ++unmatched;
+        return;
+    }
+    first->used = false;
+    if (first->id != 0 && done_count < ACK_TRACK_EXPECTED)
+    {
+        ack_event_t ev = {ACK_EVENT_DONE, first->id, NULL, 0};
+        done[done_count++] = ev;
+    }
+}
+
+bool ExoNaut_AckTracker::poll(uint32_t now_ms, ack_event_t *ev)
+{
+    if (done_count > 0)
+    {
+        *ev = done[0];
+        --done_count;
+        memmove(&done[0], &done[1], done_count * sizeof(done[0]));
+        return true;
+    }
+    for (int i = 0; i < ACK_TRACK_EXPECTED; ++i)
+    {
+        expect_t *e = &expect[i];
+        if (!e->used || before(now_ms, e->expires_ms))
+        {
+            continue;
+        }
+        if (e->id == 0)
+        {
+            e->used = false; // untracked, just stop waiting for it
+            continue;
+        }
+        ev->id = e->id;
+        ev->data = NULL;
+        ev->len = 0;
+        if (e->retries > 0)
+        {
+            --e->retries;
+            e->due_ms = now_ms + (uint32_t)exonaut_ack_delay(e->data, e->len);
+            e->expires_ms = e->due_ms + timeout_ms;
+            ev->type = ACK_EVENT_RESEND;
+            ev->data = e->data;
+            ev->len = e->len;
+        }
+        else
+        {
+            e->used = false;
+            ev->type = ACK_EVENT_TIMEOUT;
+        }
+        return true;
+    }
+    return false;
+}
+
+bool ExoNaut_AckTracker::busy(void) const
+{
+    for (int i = 0; i < ACK_TRACK_EXPECTED; ++i)
+    {
+        if (expect[i].used && expect[i].id != 0 && !expect[i].speed)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+int32_t ExoNaut_AckTracker::nextDeadline(uint32_t now_ms) const
+{
+    if (done_count > 0)
+    {
+        return 0;
+    }
+    int32_t next = -1;
+    for (int i = 0; i < ACK_TRACK_EXPECTED; ++i)
+    {
+        if (!expect[i].used)
+        {
+            continue;
+        }
+        int32_t left = (int32_t)(expect[i].expires_ms - now_ms);
+        if (left < 0)
+        {
+            left = 0;
+        }
+        if (next < 0 || left < next)
+        {
+            next = left;
+        }
+    }
+    return next;
+}
@@ -0,0 +1,96 @@
+/*
+ * ExoNaut_AckTracker.h
+ *
+ * Date: October 16th, 2026
+ *
+ * Matches the CoreX co-processor's action-finished acks to the packets that
+ * caused them.  The firmware acks every motor command (motor type and wheel
+ * speeds) as soon as it is applied and a bus servo move once its move time
+ * has passed; nothing else is acked, and an ack carries no command id.
+ *
+ * Every packet written to the UART is reported with sent(), which notes when
+ * its ack is due.  Each ack that arrives is given to the packet whose ack was
+ * due first, so the immediate acks for speed packets sent during a long servo
+ * move are not taken as the move's ack.  A due ack that has not arrived after
+ * the timeout is written off; a tracked packet (id != 0) is then resent up to
+ * the retry count and reported as timed out after that.  A tracked speed
+ * packet, such as a stop, is not resent once a newer speed packet has gone
+ * out, and is reported as replaced instead.
+ *
+ * The owner (tx_task) drives it with one clock in milliseconds and collects
+ * results and resends from poll().  This file has no Arduino dependencies.
+ */
+
+#ifndef EXONAUT_ACKTRACKER_H
+#define EXONAUT_ACKTRACKER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define ACK_TRACK_EXPECTED 16   // acks that can be due at once; the oldest untracked one is written off first
+#define ACK_TRACK_PACKET_MAX 32 // longest tracked packet, matches EXONAUT_TX_PACKET_MAX
+
+typedef enum
+{
+    ACK_EVENT_DONE = 0, // the tracked packet was acked
+    ACK_EVENT_TIMEOUT,  // no ack after every retry
+    ACK_EVENT_REPLACED, // a newer speed packet went out before the ack came
+    ACK_EVENT_RESEND,   // write data[0..len) to the UART again
+} ack_event_type_t;
+
+typedef struct __ack_event_t
+{
+    ack_event_type_t type;
+    uint32_t id;
+    const uint8_t *data; // ACK_EVENT_RESEND only, valid until the next call
+    uint8_t len;
+} ack_event_t;
+
+// Milliseconds after sending that the firmware acks pkt, or -1 if it never does
+int32_t exonaut_ack_delay(const uint8_t *pkt, uint8_t len);
+
+class ExoNaut_AckTracker
+{
+public:
+    ExoNaut_AckTracker();
+
+    void setTimeout(uint16_t timeout_ms, uint8_t retries); // used for acks due from now on
+
+    // pkt was written at now_ms; id != 0 tracks it until poll() reports a result
+    void sent(const uint8_t *pkt, uint8_t len, uint32_t id, uint32_t now_ms);
+    void acked(uint32_t now_ms); // one ack arrived
+
+    // Next result or resend at now_ms, false when there is none
+    bool poll(uint32_t now_ms, ack_event_t *ev);
+
+    // A tracked packet other than a speed packet is waiting for its ack
+    bool busy(void) const;
+    // Milliseconds until poll() has something to do without a new ack, -1 for never
+    int32_t nextDeadline(uint32_t now_ms) const;
+
+    uint32_t unmatched; // acks that arrived while none was due
+
+private:
+    struct expect_t
+    {
+        bool used;
+        bool speed;          // a wheel speed packet
+        uint32_t id;         // 0 when untracked
+        uint32_t due_ms;     // when the ack should arrive
+        uint32_t expires_ms; // written off (or resent) after this
+        uint8_t retries;
+        uint8_t len;
+        uint8_t data[ACK_TRACK_PACKET_MAX]; // kept for tracked packets only
+    };
+    expect_t *add(void);
+
+    expect_t expect[ACK_TRACK_EXPECTED];
+    uint16_t timeout_ms;
+    uint8_t retries;
+
+    // Results found by sent() and acked(), handed out by poll()
+    ack_event_t done[ACK_TRACK_EXPECTED];
+    uint8_t done_count;
+};
+
+#endif // EXONAUT_ACKTRACKER_H
@@ -0,0 +1,126 @@
+/*
+ * ExoNaut_Battery.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * Voltage filter and sag model for ExoNaut_Battery.h.
+ */
+
+#include "ExoNaut_Battery.h"
+#include <math.h>
+
+#define RLS_FORGET 0.995f // forgetting factor, about 200 load changes of memory
+#define RLS_P0 1.0e4f     // initial covariance; the first readings dominate the fit
+#define RLS_P_MAX 1.0e5f  // largest covariance trace allowed
+#define RLS_EXCITE 1.0f   // load change that counts as new information
+
+ExoNaut_Battery::ExoNaut_Battery() : filter_ms(BATTERY_FILTER_MS), warn_mv(BATTERY_WARN_MV), critical_mv(BATTERY_CRITICAL_MV), last_ms(0),
+                                     p00(RLS_P0), p01(0), p11(RLS_P0), last_load(0)
+{
+    st.volt = -1;
+    st.open_circuit = -1;
+    st.sag_per_speed = 0;
+    st.full_load = -1;
+    st.speed_limit = BATTERY_FULL_LOAD;
+    st.level = BATTERY_OK;
+}
+
+void ExoNaut_Battery::setFilter(uint16_t time_constant_ms)
+{
+    filter_ms = time_constant_ms;
+}
+
+void ExoNaut_Battery::setThresholds(float warn_mv, float critical_mv)
+{
+    this->warn_mv = warn_mv;
+    this->critical_mv = critical_mv;
+}
+
+bool ExoNaut_Battery::update(float volt_mv, float load, uint32_t now_ms)
+{
+    if (st.volt < 0)
+    {
+        st.volt = volt_mv;
+        st.open_circuit = volt_mv;
+    }
+    else
+    {
+        // No filter takes each reading as it is; two readings in the same
+        // millisecond leave a filtered voltage where it was
+        float dt = (float)(now_ms - last_ms);
+        float alpha = filter_ms == 0 ? 1.0f : dt / ((float)filter_ms + dt);
+        st.volt += alpha * (volt_mv - st.volt);
+
+        // RLS step with x = [1, -load]; the unfiltered reading tracks load steps
+        float x0 = 1.0f, x1 = -load;
+        float px0 = p00 * x0 + p01 * x1;
+        float px1 = p01 * x0 + p11 * x1;
+        float denom = RLS_FORGET + x0 * px0 + x1 * px1;
+        float k0 = px0 / denom, k1 = px1 / denom;
+        float err = volt_mv - (st.open_circuit * x0 + st.sag_per_speed * x1);
+        float oc = st.open_circuit + k0 * err;
+        float sag = st.sag_per_speed + k1 * err;
+
+        // Forget old readings only while the load is changing.  Under a steady
+        // load nothing new is learned, and dividing by RLS_FORGET every reading
+        // would grow P without bound.
+        float forget = fabsf(load - last_load) > RLS_EXCITE ? RLS_FORGET : 1.0f;
+        float n00 = (p00 - k0 * px0) / forget;
+        float n01 = (p01 - k0 * px1) / forget;
+        float n11 = (p11 - k1 * px1) / forget;
+        float trace = n00 + n11;
+        if (trace > RLS_P_MAX)
+        {
+            float scale = RLS_P_MAX / trace;
+            n00 *= scale;
+            n01 *= scale;
+            n11 *= scale;
+        }
+        if (isfinite(oc) && isfinite(sag) && isfinite(n00) && isfinite(n01) && isfinite(n11))
+        {
+            st.open_circuit = oc;
+            st.sag_per_speed = sag < 0 ? 0 : sag; // a pack never rises under load
+            p00 = n00;
+            p01 = n01;
+            p11 = n11;
+        }
+        else
+        {
+            // Keep the last good fit and start the covariance again
+            p00 = RLS_P0;
+            p01 = 0;
+            p11 = RLS_P0;
+        }
+    }
+    last_ms = now_ms;
+    last_load = load;
+    st.full_load = st.open_circuit - st.sag_per_speed * BATTERY_FULL_LOAD;
+    st.speed_limit = BATTERY_FULL_LOAD; // also the limit before any sag is measurable
+    if (st.sag_per_speed > 0 && st.open_circuit - critical_mv < st.sag_per_speed * BATTERY_FULL_LOAD)
+    {
+        st.speed_limit = (st.open_circuit - critical_mv) / st.sag_per_speed;
+        if (st.speed_limit < 0)
+        {
+            st.speed_limit = 0;
+        }
+    }
+
+    // Levels rise immediately and fall back only past the hysteresis band
+    uint8_t level = BATTERY_OK;
+    float margin = 0;
+    if (st.level != BATTERY_OK)
+    {
+        margin = BATTERY_HYSTERESIS_MV;
+    }
+    if (st.volt < critical_mv + (st.level == BATTERY_CRITICAL ? margin : 0))
+    {
+        level = BATTERY_CRITICAL;
+    }
+    else if (st.volt < warn_mv + margin || st.full_load < critical_mv + margin)
+    {
+        level = BATTERY_WARN;
+    }
+    bool changed = level != st.level;
+    st.level = level;
+    return changed;
+}
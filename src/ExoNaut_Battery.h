@@ -0,0 +1,71 @@
+/*
+ * ExoNaut_Battery.h
+ *
+ * Date: October 16th, 2026
+ *
+ * Battery monitor for the ExoNaut.  The co-processor reports the pack voltage
+ * in every 'A' frame; this filters it with a time constant in milliseconds and
+ * fits a simple sag model against the commanded motor speed:
+ *
+ *   volt = open_circuit - sag_per_speed * load
+ *
+ * where load is the mean absolute commanded speed of the two wheels.  The fit
+ * predicts the voltage under full load, so a sketch can be warned (and slow
+ * down) before a hard acceleration pulls the pack low enough to reset the
+ * ESP32.
+ *
+ * This file has no Arduino dependencies so the model can be run over recorded
+ * frames on a desktop machine.
+ */
+
+#ifndef EXONAUT_BATTERY_H
+#define EXONAUT_BATTERY_H
+
+#include <stdint.h>
+
+#define BATTERY_OK 0
+#define BATTERY_WARN 1     // low, or a full load would sag below the critical level
+#define BATTERY_CRITICAL 2 // below the critical level now
+
+#define BATTERY_FILTER_MS 2000     // default filter time constant
+#define BATTERY_WARN_MV 6800.0f    // default warning level
+#define BATTERY_CRITICAL_MV 6400.0f // default critical level
+#define BATTERY_HYSTERESIS_MV 100.0f
+#define BATTERY_FULL_LOAD 100.0f    // load, in set_motor_speed() units, used for the full load prediction
+
+typedef struct __battery_status_t
+{
+    float volt;          // filtered voltage, mV; -1 until the first reading
+    float open_circuit;  // fitted voltage with the motors stopped, mV
+    float sag_per_speed; // fitted mV lost per unit of commanded speed
+    float full_load;     // predicted voltage at BATTERY_FULL_LOAD, mV
+    float speed_limit;   // largest load predicted to stay above the critical level, at most BATTERY_FULL_LOAD
+    uint8_t level;       // BATTERY_OK, BATTERY_WARN or BATTERY_CRITICAL
+} battery_status_t;
+
+class ExoNaut_Battery
+{
+public:
+    ExoNaut_Battery();
+
+    void setFilter(uint16_t time_constant_ms); // 0 for no filtering
+    void setThresholds(float warn_mv, float critical_mv);
+
+    // Feed one reading.  Returns true when the warning level changed.
+    bool update(float volt_mv, float load, uint32_t now_ms);
+
+    const battery_status_t &status(void) const { return st; }
+
+private:
+    battery_status_t st;
+    uint16_t filter_ms;
+    float warn_mv;
+    float critical_mv;
+    uint32_t last_ms;
+
+    // Recursive least squares over [open_circuit, sag_per_speed]
+    float p00, p01, p11;
+    float last_load;
+};
+
+#endif // EXONAUT_BATTERY_H
@@ -0,0 +1,78 @@
+/*
+ * ExoNaut_BusServo.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * Implementation of the bus servo packet encoding.
+ */
+
+#include "ExoNaut_BusServo.h"
+#include "ExoNaut_Framer.h"
+#include "ExoNaut_Hex.h"
+
+size_t exonaut_servo_encode_move(const bus_servo_pose_t *poses, uint8_t count, uint16_t time, uint8_t *buf, size_t size)
+{
+    size_t len = BUS_SERVO_PACKET_SIZE(count);
+    if (count == 0 || count > BUS_SERVO_MAX_BATCH || size < len)
+    {
+        return 0;
+    }
+    buf[0] = 0x55;
+    buf[1] = 0x55;
+    buf[2] = (uint8_t)(len - 2);
+    buf[3] = BUS_SERVO_CMD_MOVE;
+    buf[4] = count;
+    buf[5] = time & 0xFF;
+    buf[6] = (time >> 8) & 0xFF;
+    uint8_t *p = &buf[7];
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        *p++ = poses[i].id;
+        *p++ = poses[i].pos & 0xFF;
+        *p++ = (poses[i].pos >> 8) & 0xFF;
+    }
+    return len;
+}
+
+size_t exonaut_servo_encode_read(uint8_t id, uint8_t *buf, size_t size)
+{
+    if (size < BUS_SERVO_READ_SIZE)
+    {
+        return 0;
+    }
+    buf[0] = 0x55;
+    buf[1] = 0x55;
+    buf[2] = BUS_SERVO_READ_SIZE - 2;
+    buf[3] = BUS_SERVO_CMD_READ;
+    buf[4] = id;
+    return BUS_SERVO_READ_SIZE;
+}
+
+bool exonaut_servo_decode_status(const uint8_t *body, uint8_t len, uint8_t format, bus_servo_reading_t *reading)
+{
+    uint8_t b[BUS_SERVO_STATUS_LEN];
+    if (len == 0 || body[0] != 'S')
+    {
+        return false;
+    }
+    if (format == EXONAUT_FRAME_BINARY)
+    {
+        if (len != 1 + BUS_SERVO_STATUS_LEN)
+        {
+            return false;
+        }
+        for (uint8_t i = 0; i < BUS_SERVO_STATUS_LEN; ++i)
+        {
+            b[i] = body[1 + i];
+        }
+    }
+    else if (len != 1 + 2 * BUS_SERVO_STATUS_LEN || !exonaut_hex_decode(body + 1, 2 * BUS_SERVO_STATUS_LEN, b))
+    {
+        return false;
+    }
+    reading->id = b[0];
+    reading->pos = (uint16_t)(b[1] | (b[2] << 8));
+    reading->volt_mv = (uint16_t)(b[3] | (b[4] << 8));
+    reading->temp_c = b[5];
+    return true;
+}
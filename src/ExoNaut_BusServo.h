@@ -0,0 +1,65 @@
+/*
+ * ExoNaut_BusServo.h
+ *
+ * Date: October 16th, 2026
+ *
+ * Packet encoding for the bus servos on the CoreX co-processor.  A move
+ * packet carries any number of servos that should start together:
+ *
+ *   0x55 0x55 | LEN | 0x03 | COUNT | TIME lo hi | (ID | POS lo hi) * COUNT
+ *
+ * where LEN = COUNT * 3 + 5 and TIME is the move time in milliseconds.
+ *
+ * A read request, 0x55 0x55 0x03 0x05 ID, asks one servo for its state.  The
+ * reply is provisional: no released co-processor firmware answers the read
+ * yet, and the layout below is the one proposed for it (ExoNaut_CoProcSim
+ * implements it).  The reply is an 'S' frame holding six bytes,
+ *
+ *   ID | POS lo hi | VOLT lo hi (mV) | TEMP (degrees C)
+ *
+ * sent as a binary payload or, in ASCII telemetry, as "S" plus the same bytes
+ * in hex and a '$'.
+ *
+ * This file has no Arduino dependencies so the encoding can be checked on a
+ * desktop machine.
+ */
+
+#ifndef EXONAUT_BUSSERVO_H
+#define EXONAUT_BUSSERVO_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define BUS_SERVO_CMD_MOVE 0x03
+#define BUS_SERVO_CMD_READ 0x05
+#define BUS_SERVO_READ_SIZE 5
+#define BUS_SERVO_STATUS_LEN 6 // bytes in an 'S' frame, after the type
+#define BUS_SERVO_MAX_BATCH 8 // servos per packet; 8 * 3 + 7 bytes fits EXONAUT_TX_PACKET_MAX
+#define BUS_SERVO_PACKET_SIZE(count) ((count) * 3 + 7)
+#define BUS_SERVO_POS_MAX 1000 // positions run from 0 to 1000 (240 degrees)
+
+typedef struct __bus_servo_pose_t
+{
+    uint8_t id;
+    uint16_t pos;
+} bus_servo_pose_t;
+
+typedef struct __bus_servo_reading_t
+{
+    uint8_t id;
+    uint16_t pos;
+    uint16_t volt_mv;
+    uint8_t temp_c;
+} bus_servo_reading_t;
+
+// Writes a move packet into buf and returns its length, or 0 when count is
+// 0, more than BUS_SERVO_MAX_BATCH, or the packet does not fit in size
+size_t exonaut_servo_encode_move(const bus_servo_pose_t *poses, uint8_t count, uint16_t time, uint8_t *buf, size_t size);
+
+// Writes a read request into buf and returns its length, 0 if it does not fit
+size_t exonaut_servo_encode_read(uint8_t id, uint8_t *buf, size_t size);
+
+// Decodes the body of an 'S' frame (type byte included) in either format
+bool exonaut_servo_decode_status(const uint8_t *body, uint8_t len, uint8_t format, bus_servo_reading_t *reading);
+
+#endif // EXONAUT_BUSSERVO_H
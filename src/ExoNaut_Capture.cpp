@@ -0,0 +1,166 @@
+/*
+ * ExoNaut_Capture.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * Implementation of the co-processor link capture log and its reader.
+ */
+
+#include "ExoNaut_Capture.h"
+#include <string.h>
+
+#define VARINT_MAX 5 // a uint32_t needs at most five LEB128 bytes
+
+ExoNaut_Capture::ExoNaut_Capture() : dropped(0), buf(NULL), size(0), used(0), last_us(0), full(false)
+{
+}
+
+bool ExoNaut_Capture::begin(uint8_t *buf, size_t size)
+{
+    if (buf == NULL || size < EXONAUT_CAPTURE_HEADER)
+    {
+        return false;
+    }
+    this->buf = buf;
+    this->size = size;
+    clear();
+    return true;
+}
+
+void ExoNaut_Capture::end(void)
+{
+    buf = NULL;
+    size = 0;
+    used = 0;
+}
+
+void ExoNaut_Capture::clear(void)
+{
+    if (buf == NULL)
+    {
+        return;
+    }
+    memcpy(buf, EXONAUT_CAPTURE_MAGIC, EXONAUT_CAPTURE_HEADER);
+    used = EXONAUT_CAPTURE_HEADER;
+    last_us = 0;
+    dropped = 0;
+    full = false;
+}
+
+void ExoNaut_Capture::record(uint8_t dir, uint32_t time_us, const uint8_t *data, size_t len)
+{
+    if (buf == NULL)
+    {
+        return;
+    }
+    while (len > 0)
+    {
+        size_t n = len > EXONAUT_CAPTURE_RECORD_MAX ? EXONAUT_CAPTURE_RECORD_MAX : len;
+        if (full || size - used < 1 + VARINT_MAX + n)
+        {
+            // Keep the log a clean prefix of the session rather than a partial record
+            full = true;
+            dropped += len;
+            return;
+        }
+        buf[used++] = (uint8_t)((dir << 7) | (n - 1));
+        uint32_t delta = time_us - last_us;
+        do
+        {
+            uint8_t b = delta & 0x7F;
+            delta >>= 7;
+            buf[used++] = delta ? (b | 0x80) : b;
+        } while (delta);
+        memcpy(&buf[used], data, n);
+        used += n;
+        last_us = time_us;
+        data += n;
+        len -= n;
+    }
+}
+
+ExoNaut_CaptureReader::ExoNaut_CaptureReader(const uint8_t *data, size_t len) : data(data), len(len), pos(EXONAUT_CAPTURE_HEADER), time_us(0)
+{
+    ok = data != NULL && len >= EXONAUT_CAPTURE_HEADER && memcmp(data, EXONAUT_CAPTURE_MAGIC, EXONAUT_CAPTURE_HEADER) == 0;
+}
+
+bool ExoNaut_CaptureReader::next(exonaut_capture_record_t *rec)
+{
+    if (!ok || pos >= len)
+    {
+        return false;
+    }
+    uint8_t tag = data[pos++];
+    uint32_t delta = 0;
+    uint8_t shift = 0;
+    for (;;)
+    {
+        if (pos >= len || shift > 28)
+        {
+            ok = false; // truncated or corrupt log
+            return false;
+        }
+        uint8_t b = data[pos++];
+        delta |= (uint32_t)(b & 0x7F) << shift;
+        shift += 7;
+        if ((b & 0x80) == 0)
+        {
+            break;
+        }
+    }
+    uint8_t n = (tag & 0x7F) + 1;
+    if (len - pos < n)
+    {
+        ok = false;
+        return false;
+    }
+    time_us += delta;
+    rec->time_us = time_us;
+    rec->dir = tag >> 7;
+    rec->data = &data[pos];
+    rec->len = n;
+    pos += n;
+    return true;
+}
+
+uint32_t exonaut_capture_replay(const uint8_t *data, size_t len, exonaut_replay_callback_t cb, void *arg, exonaut_replay_tx_callback_t tx_cb)
+{
+    ExoNaut_CaptureReader reader(data, len);
+    ExoNaut_RingBuffer ring;
+    ExoNaut_Framer framer(ring);
+    exonaut_capture_record_t rec;
+    exonaut_frame_t frame;
+    uint32_t frames = 0;
+
+    while (reader.next(&rec))
+    {
+        if (rec.dir != EXONAUT_CAPTURE_RX)
+        {
+            if (tx_cb != NULL)
+            {
+                tx_cb(&rec, arg);
+            }
+            continue;
+        }
+        size_t done = 0;
+        while (done < rec.len)
+        {
+            size_t n = ring.write(rec.data + done, rec.len - done);
+            if (n == 0)
+            {
+                framer.reset(); // same recovery as rx_task
+                continue;
+            }
+            done += n;
+            while (framer.next(&frame))
+            {
+                ++frames;
+                if (cb != NULL)
+                {
+                    cb(&frame, rec.time_us, arg);
+                }
+            }
+        }
+    }
+    return frames;
+}
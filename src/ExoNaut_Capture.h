@@ -0,0 +1,102 @@
+/*
+ * ExoNaut_Capture.h
+ *
+ * Date: October 16th, 2026
+ *
+ * Record and replay of the CoreX co-processor link.  While a capture is
+ * running every block of bytes rx_task reads from the UART and every packet
+ * the library writes to it is appended to a RAM log with a timestamp.  The
+ * log can be dumped over USB serial or saved to flash and fed back through
+ * ExoNaut_Framer and ExoNaut_Telemetry on a desktop machine.
+ *
+ * Log layout: the four bytes "EXC1", then one record per block:
+ *
+ *   TAG | DELTA | DATA[len]
+ *
+ * TAG holds the direction in bit 7 (0 received, 1 sent) and len - 1 in bits
+ * 0-6, so a record carries 1 to 128 bytes.  DELTA is the time in microseconds
+ * since the previous record (since zero for the first one) as an unsigned
+ * LEB128 varint; most records need a single byte.  Longer blocks are split
+ * into several records.  Recording stops when the log is full.
+ *
+ * This file has no Arduino dependencies.
+ */
+
+#ifndef EXONAUT_CAPTURE_H
+#define EXONAUT_CAPTURE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "ExoNaut_Framer.h"
+
+#define EXONAUT_CAPTURE_RX 0
+#define EXONAUT_CAPTURE_TX 1
+
+#define EXONAUT_CAPTURE_MAGIC "EXC1"
+#define EXONAUT_CAPTURE_HEADER 4
+#define EXONAUT_CAPTURE_RECORD_MAX 128 // data bytes per record
+#define EXONAUT_CAPTURE_DEFAULT_SIZE 8192
+
+typedef struct __exonaut_capture_record_t
+{
+    uint32_t time_us;    // micros() when the block was read or written
+    uint8_t dir;         // EXONAUT_CAPTURE_RX or EXONAUT_CAPTURE_TX
+    const uint8_t *data; // points into the log
+    uint8_t len;
+} exonaut_capture_record_t;
+
+// Called by exonaut_capture_replay() for every frame in the received bytes
+typedef void (*exonaut_replay_callback_t)(const exonaut_frame_t *frame, uint32_t time_us, void *arg);
+// and, if given, for every block the log recorded going out
+typedef void (*exonaut_replay_tx_callback_t)(const exonaut_capture_record_t *rec, void *arg);
+
+class ExoNaut_Capture
+{
+public:
+    ExoNaut_Capture();
+
+    // Starts a new log in buf, which must stay valid until end()
+    bool begin(uint8_t *buf, size_t size);
+    void end(void);
+    void clear(void);
+
+    void record(uint8_t dir, uint32_t time_us, const uint8_t *data, size_t len);
+
+    bool active(void) const { return buf != NULL; }
+    const uint8_t *data(void) const { return buf; }
+    size_t length(void) const { return used; }
+
+    uint32_t dropped; // bytes not recorded because the log was full
+
+private:
+    uint8_t *buf;
+    size_t size;
+    size_t used;
+    uint32_t last_us;
+    bool full;
+};
+
+class ExoNaut_CaptureReader
+{
+public:
+    ExoNaut_CaptureReader(const uint8_t *data, size_t len);
+
+    bool valid(void) const { return ok; } // the log starts with the expected header
+    bool next(exonaut_capture_record_t *rec);
+
+private:
+    const uint8_t *data;
+    size_t len;
+    size_t pos;
+    uint32_t time_us;
+    bool ok;
+};
+
+// Feeds the received bytes of a log through a fresh framer, the same way
+// rx_task does, and returns the number of frames found.  Both callbacks see
+// the log in the order it was recorded.  To also decode the frames as rx_task
+// does, use exonaut_telemetry_replay() in ExoNaut_Telemetry.h.
+uint32_t exonaut_capture_replay(const uint8_t *data, size_t len, exonaut_replay_callback_t cb, void *arg,
+                                exonaut_replay_tx_callback_t tx_cb = NULL);
+
+#endif // EXONAUT_CAPTURE_H
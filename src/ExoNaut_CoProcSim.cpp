@@ -0,0 +1,419 @@
+/*
+ * ExoNaut_CoProcSim.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * Implementation of the simulated CoreX co-processor.
+ */
+
+#include "ExoNaut_CoProcSim.h"
+#include "ExoNaut_Framer.h"
+#include "ExoNaut_BusServo.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#define SIM_STEP_US 1000          // physics integration step
+#define SIM_PPS_SCALE (100.0f / 680.0f) // rev/s per unit of the speed byte, see encoder_motor_set_speed_base()
+#define SIM_VOLT_LSB 51.765f      // mV per unit of the status frame voltage byte
+
+ExoNaut_CoProcSim::ExoNaut_CoProcSim() : last_speed_us(0), first_encoder_us(0), packets(0), bad_packets(0), overflows(0),
+                                         rx_len(0), out_head(0), out_count(0), version(200), tau_s(COPROC_SIM_TAU_MS * 0.001f),
+                                         pulses(1120), open_mv(COPROC_SIM_OPEN_MV), sag_mv(COPROC_SIM_SAG_MV),
+                                         drain_mv(COPROC_SIM_DRAIN_MV), ir_code(0), now_us(0), status_us(0), status_ms(COPROC_SIM_STATUS_MS),
+                                         stream_us(0), ack_due_us(0)
+{
+    reset();
+}
+
+void ExoNaut_CoProcSim::reset(void)
+{
+    rx_len = 0;
+    drained_mv = 0;
+    for (int i = 0; i < 2; ++i)
+    {
+        target[i] = 0;
+        speed[i] = 0;
+        pos[i] = 0;
+    }
+    for (int i = 0; i < COPROC_SIM_SERVOS; ++i)
+    {
+        servo_id[i] = 0;
+        servo_pos[i] = 500;
+    }
+    started = false;
+    stream_period_us = 0;
+    ack_pending = false;
+    binary_mode = false;
+    encoder_seq = 0;
+    latency_armed = false;
+}
+
+void ExoNaut_CoProcSim::setVersion(uint16_t version)
+{
+    this->version = version % 1000; // the 'V' frame has room for three digits
+}
+
+void ExoNaut_CoProcSim::setTimeConstant(uint16_t tau_ms)
+{
+    tau_s = tau_ms * 0.001f;
+}
+
+void ExoNaut_CoProcSim::setPulseCount(uint16_t pulses)
+{
+    this->pulses = pulses;
+}
+
+void ExoNaut_CoProcSim::setBattery(float open_mv, float sag_mv_per_rps, float drain_mv_per_rev)
+{
+    this->open_mv = open_mv;
+    sag_mv = sag_mv_per_rps;
+    drain_mv = drain_mv_per_rev;
+}
+
+void ExoNaut_CoProcSim::setStatusInterval(uint16_t ms)
+{
+    status_ms = ms;
+}
+
+void ExoNaut_CoProcSim::setIRCode(uint16_t code)
+{
+    ir_code = code;
+}
+
+float ExoNaut_CoProcSim::wheelSpeed(uint8_t motor) const
+{
+    return (motor == 1 || motor == 2) ? speed[motor - 1] : 0;
+}
+
+int32_t ExoNaut_CoProcSim::count(uint8_t motor) const
+{
+    return (motor == 1 || motor == 2) ? (int32_t)floor(pos[motor - 1]) : 0;
+}
+
+float ExoNaut_CoProcSim::voltage(void) const
+{
+    return open_mv - drained_mv - sag_mv * (fabsf(speed[0]) + fabsf(speed[1]));
+}
+
+void ExoNaut_CoProcSim::feed(const uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; ++i)
+    {
+        uint8_t b = data[i];
+        if (rx_len < 2)
+        {
+            if (b == 0x55)
+            {
+                rx[rx_len++] = b;
+            }
+            else
+            {
+                rx_len = 0;
+            }
+            continue;
+        }
+        if (rx_len == 2)
+        {
+            if (b == 0x55)
+            {
+                continue; // a longer run of headers, keep waiting for the length
+            }
+            if (b < 2 || b + 2 > COPROC_SIM_PACKET_MAX)
+            {
+                ++bad_packets;
+                rx_len = 0;
+                continue;
+            }
+        }
+        rx[rx_len++] = b;
+        if (rx_len >= 3 && rx_len == rx[2] + 2)
+        {
+            handlePacket(rx, rx_len);
+            rx_len = 0;
+        }
+    }
+}
+
+size_t ExoNaut_CoProcSim::available(void) const
+{
+    return out_count;
+}
+
+size_t ExoNaut_CoProcSim::read(uint8_t *dst, size_t max)
+{
+    size_t n = 0;
+    while (n < max && out_count > 0)
+    {
+        dst[n++] = out[out_head];
+        out_head = (out_head + 1) % COPROC_SIM_OUT_SIZE;
+        --out_count;
+    }
+    return n;
+}
+
+void ExoNaut_CoProcSim::put(const uint8_t *data, size_t len)
+{
+    if (COPROC_SIM_OUT_SIZE - out_count < len)
+    {
+        overflows += len; // whole frames only, as a UART FIFO overrun would corrupt one
+        return;
+    }
+    for (size_t i = 0; i < len; ++i)
+    {
+        out[(out_head + out_count) % COPROC_SIM_OUT_SIZE] = data[i];
+        ++out_count;
+    }
+}
+
+void ExoNaut_CoProcSim::sendBinary(uint8_t type, const uint8_t *payload, uint8_t len)
+{
+    uint8_t frame[EXONAUT_BIN_PAYLOAD_MAX + EXONAUT_BIN_OVERHEAD];
+    frame[0] = EXONAUT_BIN_SYNC;
+    frame[1] = len;
+    frame[2] = type;
+    memcpy(&frame[3], payload, len);
+    frame[3 + len] = exonaut_crc8(&frame[1], len + 2);
+    put(frame, len + EXONAUT_BIN_OVERHEAD);
+}
+
+void ExoNaut_CoProcSim::sendVersion(void)
+{
+    char text[8];
+    snprintf(text, sizeof(text), "V%03u", version);
+    if (binary_mode)
+    {
+        sendBinary('V', (const uint8_t *)text, 4);
+    }
+    else
+    {
+        text[4] = '$';
+        put((const uint8_t *)text, 5);
+    }
+}
+
+void ExoNaut_CoProcSim::sendStatus(void)
+{
+    float mv = voltage();
+    int raw = (int)(mv / SIM_VOLT_LSB + 0.5f);
+    uint8_t volt = raw < 0 ? 0 : (raw > 255 ? 255 : (uint8_t)raw);
+    if (binary_mode)
+    {
+        uint8_t pl[3] = {volt, (uint8_t)ir_code, (uint8_t)(ir_code >> 8)};
+        sendBinary('A', pl, 3);
+    }
+    else
+    {
+        char text[10];
+        snprintf(text, sizeof(text), "A%02X%02X%02X$", volt, ir_code & 0xFF, ir_code >> 8);
+        put((const uint8_t *)text, 8);
+    }
+}
+
+void ExoNaut_CoProcSim::sendEncoder(void)
+{
+    int32_t c1 = count(1);
+    int32_t c2 = count(2);
+    if (binary_mode)
+    {
+        uint8_t pl[9];
+        pl[0] = encoder_seq++;
+        for (int i = 0; i < 4; ++i)
+        {
+            pl[1 + i] = (uint8_t)((uint32_t)c1 >> (8 * i));
+            pl[5 + i] = (uint8_t)((uint32_t)c2 >> (8 * i));
+        }
+        sendBinary('E', pl, 9);
+    }
+    else
+    {
+        char text[24];
+        snprintf(text, sizeof(text), "EMM%08X%08X$", (unsigned)c2, (unsigned)c1); // motor 2 first
+        put((const uint8_t *)text, 20);
+    }
+    if (latency_armed)
+    {
+        first_encoder_us = now_us;
+        latency_armed = false;
+    }
+}
+
+void ExoNaut_CoProcSim::sendAck(void)
+{
+    if (binary_mode)
+    {
+        sendBinary('A', NULL, 0);
+    }
+    else
+    {
+        put((const uint8_t *)"AOK$", 4);
+    }
+}
+
+void ExoNaut_CoProcSim::sendServo(uint8_t id)
+{
+    uint16_t p = 500; // centre until the servo has been moved
+    for (int i = 0; i < COPROC_SIM_SERVOS; ++i)
+    {
+        if (servo_id[i] == id)
+        {
+            p = servo_pos[i];
+        }
+    }
+    uint16_t mv = (uint16_t)voltage();
+    uint8_t pl[BUS_SERVO_STATUS_LEN] = {id, (uint8_t)p, (uint8_t)(p >> 8), (uint8_t)mv, (uint8_t)(mv >> 8), 30};
+    if (binary_mode)
+    {
+        sendBinary('S', pl, BUS_SERVO_STATUS_LEN);
+    }
+    else
+    {
+        char text[2 + 2 * BUS_SERVO_STATUS_LEN + 1];
+        text[0] = 'S';
+        for (int i = 0; i < BUS_SERVO_STATUS_LEN; ++i)
+        {
+            snprintf(&text[1 + 2 * i], 3, "%02X", pl[i]);
+        }
+        text[1 + 2 * BUS_SERVO_STATUS_LEN] = '$';
+        put((const uint8_t *)text, 2 + 2 * BUS_SERVO_STATUS_LEN);
+    }
+}
+
+void ExoNaut_CoProcSim::handlePacket(const uint8_t *pkt, uint8_t len)
+{
+    uint8_t cmd = pkt[3];
+    ++packets;
+    if (cmd == 55 && len >= 5)
+    {
+        uint8_t sub = pkt[4];
+        if (sub == 0x01 && len == 6)
+        { // motor type
+            if (pkt[5] == 1 || pkt[5] == 2)
+            {
+                pulses = pkt[5] == 1 ? 1120 : 1431;
+            }
+            sendAck();
+            return;
+        }
+        if (sub == 0x02 && len == 7)
+        { // wheel speeds
+            target[0] = (int8_t)pkt[5];
+            target[1] = (int8_t)pkt[6];
+            last_speed_us = now_us;
+            latency_armed = true;
+            sendAck();
+            return;
+        }
+        if (sub == 0x03 && len == 5)
+        { // encoder count request
+            sendEncoder();
+            return;
+        }
+        if (sub == 0x10 && len == 6)
+        { // telemetry format, only understood by binary capable firmware
+            if (version >= 200)
+            {
+                binary_mode = pkt[5] != 0;
+                if (binary_mode)
+                {
+                    sendVersion(); // confirms the switch
+                }
+            }
+            return;
+        }
+        if (sub == 0x11 && len == 6)
+        { // encoder stream rate in Hz, 0 stops it
+            stream_period_us = pkt[5] ? 1000000UL / pkt[5] : 0;
+            stream_us = now_us;
+            return;
+        }
+    }
+    else if (cmd == BUS_SERVO_CMD_READ && len == BUS_SERVO_READ_SIZE)
+    {
+        sendServo(pkt[4]);
+        return;
+    }
+    else if (cmd == BUS_SERVO_CMD_MOVE && len >= 10 && len == BUS_SERVO_PACKET_SIZE(pkt[4]))
+    { // bus servo move: the servos jump to the target, the ack comes once the move time has passed
+        for (uint8_t n = 0; n < pkt[4]; ++n)
+        {
+            const uint8_t *p = &pkt[7 + 3 * n];
+            int slot = -1;
+            for (int i = 0; i < COPROC_SIM_SERVOS && slot < 0; ++i)
+            {
+                if (servo_id[i] == p[0] || servo_id[i] == 0)
+                {
+                    slot = i;
+                }
+            }
+            if (slot >= 0)
+            {
+                servo_id[slot] = p[0];
+                servo_pos[slot] = p[1] | (p[2] << 8);
+            }
+        }
+        uint16_t time_ms = pkt[5] | (pkt[6] << 8);
+        ack_due_us = now_us + time_ms * 1000UL;
+        ack_pending = true;
+        return;
+    }
+    --packets;
+    ++bad_packets;
+}
+
+void ExoNaut_CoProcSim::physics(float dt_s)
+{
+    float volt = voltage();
+    float headroom = volt / open_mv; // a sagging pack cannot reach the commanded speed
+    if (headroom < 0)
+    {
+        headroom = 0;
+    }
+    float k = tau_s > 0 ? dt_s / (tau_s + dt_s) : 1.0f;
+    for (int i = 0; i < 2; ++i)
+    {
+        float goal = target[i] * SIM_PPS_SCALE * headroom;
+        speed[i] += (goal - speed[i]) * k;
+        double revs = speed[i] * dt_s;
+        pos[i] += revs * pulses;
+        drained_mv += drain_mv * (float)fabs(revs);
+    }
+}
+
+void ExoNaut_CoProcSim::step(uint32_t now_us)
+{
+    if (!started)
+    {
+        started = true;
+        this->now_us = now_us;
+        status_us = now_us;
+        sendVersion();
+        return;
+    }
+    while ((int32_t)(now_us - this->now_us) > 0)
+    {
+        uint32_t dt = now_us - this->now_us;
+        if (dt > SIM_STEP_US)
+        {
+            dt = SIM_STEP_US;
+        }
+        this->now_us += dt;
+        physics(dt * 1e-6f);
+
+        if ((int32_t)(this->now_us - status_us) >= (int32_t)(status_ms * 1000UL))
+        {
+            status_us = this->now_us;
+            sendStatus();
+        }
+        if (stream_period_us != 0 && (int32_t)(this->now_us - stream_us) >= (int32_t)stream_period_us)
+        {
+            stream_us += stream_period_us;
+            sendEncoder();
+        }
+        if (ack_pending && (int32_t)(this->now_us - ack_due_us) >= 0)
+        {
+            ack_pending = false;
+            sendAck();
+        }
+    }
+}
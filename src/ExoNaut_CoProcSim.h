@@ -0,0 +1,131 @@
+/*
+ * ExoNaut_CoProcSim.h
+ *
+ * Date: October 16th, 2026
+ *
+ * A stand-in for the CoreX co-processor.  It accepts the 0x55 0x55 packets
+ * the exonaut class sends and answers with the same telemetry the real board
+ * produces: a 'V' frame at start up, periodic 'A' status frames, encoder
+ * frames on request or as a stream, short 'A' acks, and 'S' bus servo
+ * readings.  Binary frames are used after the 0x10 telemetry command, as with
+ * firmware V200 and later.
+ *
+ * Acks follow the firmware: every motor command, the motor type and each
+ * wheel speed packet, is acknowledged as soon as it is applied, and a bus
+ * servo move once its move time has passed.  Requests answered with data
+ * (encoder counts, servo reads) and the telemetry format and stream rate
+ * settings get no ack.  An ack carries no command id.
+ *
+ * Two encoder motors are modelled as first order systems with a settable time
+ * constant, counting pulses at a settable resolution.  The battery voltage
+ * sags with wheel speed and drifts down as the wheels turn, and a sagging pack
+ * also lowers the top speed.
+ *
+ * The simulator only moves bytes: feed() takes what the library wrote and
+ * read() returns what the co-processor would send back, with step() advancing
+ * simulated time.  A desktop test connects these to a pseudo-terminal or to a
+ * HardwareSerial stand-in; the simulator itself has no Arduino dependencies.
+ */
+
+#ifndef EXONAUT_COPROCSIM_H
+#define EXONAUT_COPROCSIM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define COPROC_SIM_OUT_SIZE 512     // bytes of telemetry waiting for read()
+#define COPROC_SIM_PACKET_MAX 32    // longest packet accepted, matches EXONAUT_TX_PACKET_MAX
+#define COPROC_SIM_STATUS_MS 50     // default interval between 'A' status frames
+#define COPROC_SIM_TAU_MS 80        // default motor time constant
+#define COPROC_SIM_OPEN_MV 8100.0f  // default open circuit voltage
+#define COPROC_SIM_SAG_MV 60.0f     // default mV lost per wheel revolution per second
+#define COPROC_SIM_DRAIN_MV 0.05f   // default mV lost per wheel revolution
+#define COPROC_SIM_SERVOS 8         // bus servos the simulator remembers
+
+class ExoNaut_CoProcSim
+{
+public:
+    ExoNaut_CoProcSim();
+
+    // Host side of the link
+    void feed(const uint8_t *data, size_t len); // bytes written by the library
+    size_t read(uint8_t *dst, size_t max);      // telemetry for the library
+    size_t available(void) const;
+
+    // Advances the model to now_us, emitting any frames that fall due
+    void step(uint32_t now_us);
+    void reset(void); // power cycle: counts cleared, 'V' frame sent again
+
+    // Model parameters
+    void setVersion(uint16_t version);   // reported as "V<version>", binary telemetry needs 200 or more
+    void setTimeConstant(uint16_t tau_ms);
+    void setPulseCount(uint16_t pulses); // pulses per output shaft revolution
+    void setBattery(float open_mv, float sag_mv_per_rps, float drain_mv_per_rev);
+    void setStatusInterval(uint16_t ms);
+    void setIRCode(uint16_t code);       // key reported in the following status frames, 0 for none
+
+    // Model state
+    float wheelSpeed(uint8_t motor) const; // output shaft rev/s, motor 1 or 2
+    int32_t count(uint8_t motor) const;    // raw pulse count as sent on the wire
+    float voltage(void) const;             // mV under the current load
+    bool binary(void) const { return binary_mode; }
+
+    // Time in microseconds of the last speed packet and of the first encoder
+    // frame sent after it, for command-to-encoder latency measurements
+    uint32_t last_speed_us;
+    uint32_t first_encoder_us;
+
+    uint32_t packets;     // packets accepted
+    uint32_t bad_packets; // unknown commands or bad lengths
+    uint32_t overflows;   // telemetry bytes lost because read() fell behind
+
+private:
+    void handlePacket(const uint8_t *pkt, uint8_t len);
+    void physics(float dt_s);
+    void sendVersion(void);
+    void sendStatus(void);
+    void sendEncoder(void);
+    void sendAck(void);
+    void sendServo(uint8_t id);
+    void sendBinary(uint8_t type, const uint8_t *payload, uint8_t len);
+    void put(const uint8_t *data, size_t len);
+
+    // Packet parser
+    uint8_t rx[COPROC_SIM_PACKET_MAX];
+    uint8_t rx_len;
+
+    // Telemetry queue
+    uint8_t out[COPROC_SIM_OUT_SIZE];
+    size_t out_head;
+    size_t out_count;
+
+    // Model
+    uint16_t version;
+    float tau_s;
+    uint16_t pulses;
+    float open_mv;
+    float sag_mv;
+    float drain_mv;
+    float drained_mv;
+    int8_t target[2];  // speed bytes from the last speed packet
+    float speed[2];    // rev/s
+    double pos[2];     // pulses
+    uint16_t ir_code;
+    uint8_t servo_id[COPROC_SIM_SERVOS]; // 0 marks a free slot
+    uint16_t servo_pos[COPROC_SIM_SERVOS];
+
+    // Scheduling
+    bool started;
+    uint32_t now_us;
+    uint32_t status_us;
+    uint16_t status_ms;
+    uint32_t stream_us;
+    uint32_t stream_period_us; // 0 when not streaming
+    uint32_t ack_due_us;
+    bool ack_pending;
+    bool binary_mode;
+    uint8_t encoder_seq;
+    bool latency_armed;
+};
+
+#endif // EXONAUT_COPROCSIM_H
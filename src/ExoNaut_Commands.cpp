@@ -0,0 +1,71 @@
+/*
+ * ExoNaut_Commands.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * Implementation of the motor and link command encoding.
+ */
+
+#include "ExoNaut_Commands.h"
+
+// Header and sub command of a packet with nargs argument bytes; 0 if it does not fit
+static size_t begin_packet(uint8_t sub, size_t nargs, uint8_t *buf, size_t size)
+{
+    size_t len = 5 + nargs;
+    if (size < len)
+    {
+        return 0;
+    }
+    buf[0] = 0x55;
+    buf[1] = 0x55;
+    buf[2] = (uint8_t)(len - 2);
+    buf[3] = EXONAUT_MOTOR_CMD;
+    buf[4] = sub;
+    return len;
+}
+
+size_t exonaut_encode_speed(int8_t byte_1, int8_t byte_2, uint8_t *buf, size_t size)
+{
+    size_t len = begin_packet(EXONAUT_SUB_SPEED, 2, buf, size);
+    if (len != 0)
+    {
+        buf[5] = (uint8_t)byte_1;
+        buf[6] = (uint8_t)byte_2;
+    }
+    return len;
+}
+
+size_t exonaut_encode_motor_type(uint8_t type, uint8_t *buf, size_t size)
+{
+    size_t len = begin_packet(EXONAUT_SUB_MOTOR_TYPE, 1, buf, size);
+    if (len != 0)
+    {
+        buf[5] = type;
+    }
+    return len;
+}
+
+size_t exonaut_encode_encoder_request(uint8_t *buf, size_t size)
+{
+    return begin_packet(EXONAUT_SUB_ENCODER, 0, buf, size);
+}
+
+size_t exonaut_encode_telemetry_format(bool binary, uint8_t *buf, size_t size)
+{
+    size_t len = begin_packet(EXONAUT_SUB_TELEMETRY, 1, buf, size);
+    if (len != 0)
+    {
+        buf[5] = binary ? 0x01 : 0x00;
+    }
+    return len;
+}
+
+size_t exonaut_encode_stream_rate(uint8_t rate_hz, uint8_t *buf, size_t size)
+{
+    size_t len = begin_packet(EXONAUT_SUB_STREAM, 1, buf, size);
+    if (len != 0)
+    {
+        buf[5] = rate_hz;
+    }
+    return len;
+}
@@ -0,0 +1,49 @@
+/*
+ * ExoNaut_Commands.h
+ *
+ * Date: October 16th, 2026
+ *
+ * Packet encoding for the encoder motor and link commands to the CoreX
+ * co-processor.  They all share one command byte and differ in the sub
+ * command after it:
+ *
+ *   0x55 0x55 | LEN | 55 | SUB | ARGS
+ *
+ *   SUB 0x01  motor type, 1 or 2
+ *   SUB 0x02  wheel speeds, one signed speed byte per wheel (negative forwards)
+ *   SUB 0x03  encoder count request, answered with an encoder frame
+ *   SUB 0x10  telemetry format, 1 for binary frames and 0 for ASCII
+ *   SUB 0x11  encoder stream rate in Hz, 0 to stop
+ *
+ * where LEN counts the bytes after it.  Bus servo packets are encoded by
+ * ExoNaut_BusServo.h.
+ *
+ * This file has no Arduino dependencies so the packets can be fed to
+ * ExoNaut_CoProcSim on a desktop machine.
+ */
+
+#ifndef EXONAUT_COMMANDS_H
+#define EXONAUT_COMMANDS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define EXONAUT_MOTOR_CMD 55
+#define EXONAUT_SUB_MOTOR_TYPE 0x01
+#define EXONAUT_SUB_SPEED 0x02
+#define EXONAUT_SUB_ENCODER 0x03
+#define EXONAUT_SUB_TELEMETRY 0x10
+#define EXONAUT_SUB_STREAM 0x11
+
+#define EXONAUT_SPEED_PACKET_SIZE 7
+#define EXONAUT_ENCODER_REQUEST_SIZE 5
+#define EXONAUT_SETTING_PACKET_SIZE 6 // motor type, telemetry format and stream rate
+
+// Each writes its packet into buf and returns the length, 0 if it does not fit in size
+size_t exonaut_encode_speed(int8_t byte_1, int8_t byte_2, uint8_t *buf, size_t size);
+size_t exonaut_encode_motor_type(uint8_t type, uint8_t *buf, size_t size);
+size_t exonaut_encode_encoder_request(uint8_t *buf, size_t size);
+size_t exonaut_encode_telemetry_format(bool binary, uint8_t *buf, size_t size);
+size_t exonaut_encode_stream_rate(uint8_t rate_hz, uint8_t *buf, size_t size);
+
+#endif // EXONAUT_COMMANDS_H
@@ -0,0 +1,272 @@
+/*
+ * ExoNaut_Framer.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * Implementation of the co-processor ring buffer and frame splitter.
+ */
+
+#include "ExoNaut_Framer.h"
+#include <string.h>
+
+#define RING_MASK (EXONAUT_RX_RING_SIZE - 1)
+
+static_assert((EXONAUT_RX_RING_SIZE & RING_MASK) == 0, "EXONAUT_RX_RING_SIZE must be a power of two");
+static_assert(EXONAUT_FRAME_MAX < EXONAUT_RX_RING_SIZE, "a frame must fit in the ring");
+static_assert(EXONAUT_BIN_PAYLOAD_MAX + 2 <= EXONAUT_FRAME_MAX, "a binary frame must fit in the scratch buffer");
+
+uint8_t exonaut_crc8(const uint8_t *data, size_t len, uint8_t crc)
+{
+    while (len--)
+    {
+        crc ^= *data++;
+        for (uint8_t bit = 0; bit < 8; ++bit)
+        {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+ExoNaut_RingBuffer::ExoNaut_RingBuffer() : head(0), tail(0)
+{
+}
+
+size_t ExoNaut_RingBuffer::writeSpan(uint8_t **ptr)
+{
+    uint32_t h = head.load(std::memory_order_relaxed);
+    uint32_t t = tail.load(std::memory_order_acquire);
+    size_t free_bytes = EXONAUT_RX_RING_SIZE - (h - t);
+    size_t idx = h & RING_MASK;
+    size_t to_end = EXONAUT_RX_RING_SIZE - idx;
+    *ptr = &buf[idx];
+    return free_bytes < to_end ? free_bytes : to_end;
+}
+
+void ExoNaut_RingBuffer::commit(size_t n)
+{
+    head.store(head.load(std::memory_order_relaxed) + n, std::memory_order_release);
+}
+
+size_t ExoNaut_RingBuffer::write(const uint8_t *src, size_t n)
+{
+    size_t total = 0;
+    while (total < n)
+    {
+        uint8_t *dst;
+        size_t span = writeSpan(&dst);
+        if (span == 0)
+        {
+            break; // full, the rest is dropped
+        }
+        if (span > n - total)
+        {
+            span = n - total;
+        }
+        memcpy(dst, src + total, span);
+        commit(span);
+        total += span;
+    }
+    return total;
+}
+
+size_t ExoNaut_RingBuffer::available(void) const
+{
+    return head.load(std::memory_order_acquire) - tail.load(std::memory_order_relaxed);
+}
+
+uint8_t ExoNaut_RingBuffer::peek(size_t offset) const
+{
+    return buf[(tail.load(std::memory_order_relaxed) + offset) & RING_MASK];
+}
+
+size_t ExoNaut_RingBuffer::readSpan(size_t offset, const uint8_t **ptr) const
+{
+    size_t avail = available();
+    if (offset >= avail)
+    {
+        *ptr = NULL;
+        return 0;
+    }
+    size_t idx = (tail.load(std::memory_order_relaxed) + offset) & RING_MASK;
+    size_t to_end = EXONAUT_RX_RING_SIZE - idx;
+    *ptr = &buf[idx];
+    return (avail - offset) < to_end ? (avail - offset) : to_end;
+}
+
+void ExoNaut_RingBuffer::consume(size_t n)
+{
+    tail.store(tail.load(std::memory_order_relaxed) + n, std::memory_order_release);
+}
+
+void ExoNaut_RingBuffer::reset(void)
+{
+    tail.store(head.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+ExoNaut_Framer::ExoNaut_Framer(ExoNaut_RingBuffer &ring) : dropped(0), crc_errors(0), ring(ring), pending(0), scanned(0), discarding(false)
+{
+}
+
+void ExoNaut_Framer::reset(void)
+{
+    ring.reset();
+    pending = 0;
+    scanned = 0;
+    discarding = false;
+}
+
+bool ExoNaut_Framer::next(exonaut_frame_t *frame)
+{
+    if (pending > 0)
+    {
+        ring.consume(pending);
+        pending = 0;
+    }
+
+    for (;;)
+    {
+        if (scanned == 0)
+        {
+            // CR/LF between frames is not part of either frame
+            while (ring.available() > 0 && (ring.peek(0) == '\r' || ring.peek(0) == '\n'))
+            {
+                ring.consume(1);
+            }
+            if (!discarding && ring.available() > 0 && ring.peek(0) == EXONAUT_BIN_SYNC)
+            {
+                bool wait;
+                if (nextBinary(frame, &wait))
+                {
+                    return true;
+                }
+                if (wait)
+                {
+                    return false;
+                }
+                continue; // one byte was dropped to resynchronise
+            }
+        }
+
+        // Search only the bytes that arrived since the last call
+        size_t avail = ring.available();
+        bool found = false;
+        bool resync = false;
+        while (scanned < avail)
+        {
+            const uint8_t *p;
+            size_t span = ring.readSpan(scanned, &p);
+            const uint8_t *term = (const uint8_t *)memchr(p, EXONAUT_FRAME_TERMINATOR, span);
+            size_t limit = term != NULL ? (size_t)(term - p) : span;
+            const uint8_t *sync = (const uint8_t *)memchr(p, EXONAUT_BIN_SYNC, limit);
+            if (sync != NULL)
+            {
+                // ASCII text never holds a sync byte; what came before it is debris
+                ring.consume(scanned + (sync - p));
+                scanned = 0;
+                discarding = false;
+                ++dropped;
+                resync = true;
+                break;
+            }
+            if (term != NULL)
+            {
+                scanned += term - p;
+                found = true;
+                break;
+            }
+            scanned += span;
+        }
+        if (resync)
+        {
+            continue;
+        }
+
+        if (!found)
+        {
+            if (scanned > EXONAUT_FRAME_MAX)
+            {
+                // No terminator in sight; free the space and drop up to the next '$'
+                if (!discarding)
+                {
+                    discarding = true;
+                    ++dropped;
+                }
+                ring.consume(scanned);
+                scanned = 0;
+            }
+            return false;
+        }
+
+        size_t len = scanned;
+        scanned = 0;
+        if (discarding || len > EXONAUT_FRAME_MAX)
+        {
+            if (!discarding)
+            {
+                ++dropped;
+            }
+            discarding = false;
+            ring.consume(len + 1);
+            continue;
+        }
+
+        frame->data = view(0, len);
+        frame->len = (uint8_t)len;
+        frame->format = EXONAUT_FRAME_ASCII;
+        pending = len + 1;
+        return true;
+    }
+}
+
+bool ExoNaut_Framer::nextBinary(exonaut_frame_t *frame, bool *wait)
+{
+    size_t avail = ring.available();
+    *wait = false;
+    if (avail < 2)
+    {
+        *wait = true;
+        return false;
+    }
+    uint8_t len = ring.peek(1);
+    if (len > EXONAUT_BIN_PAYLOAD_MAX)
+    {
+        ++crc_errors;
+        ring.consume(1);
+        return false;
+    }
+    size_t total = len + EXONAUT_BIN_OVERHEAD;
+    if (avail < total)
+    {
+        *wait = true;
+        return false;
+    }
+    const uint8_t *p = view(1, len + 2); // LEN, TYPE and PAYLOAD
+    if (exonaut_crc8(p, len + 2) != ring.peek(total - 1))
+    {
+        ++crc_errors;
+        ring.consume(1);
+        return false;
+    }
+    frame->data = p + 1;
+    frame->len = len + 1;
+    frame->format = EXONAUT_FRAME_BINARY;
+    pending = total;
+    return true;
+}
+
+const uint8_t *ExoNaut_Framer::view(size_t offset, size_t len)
+{
+    const uint8_t *p;
+    size_t span = ring.readSpan(offset, &p);
+    if (span < len)
+    {
+        // The frame straddles the end of the ring; linearise it
+        memcpy(scratch, p, span);
+        const uint8_t *rest;
+        ring.readSpan(offset + span, &rest);
+        memcpy(scratch + span, rest, len - span);
+        p = scratch;
+    }
+    return p;
+}
@@ -0,0 +1,98 @@
+/*
+ * ExoNaut_Framer.h
+ *
+ * Date: October 16th, 2026
+ *
+ * Receive path for the CoreX co-processor link.  Bytes read from the UART are
+ * written straight into a single-producer/single-consumer ring buffer and the
+ * framer hands back each '$' terminated frame as a (pointer, length) view into
+ * the ring, so nothing is copied or cleared per frame.
+ *
+ * Two frame formats share the link.  The legacy ASCII telemetry is printable
+ * text ending in '$'.  Binary frames are length prefixed and CRC protected:
+ *
+ *   0xA5 | LEN | TYPE | PAYLOAD[LEN] | CRC-8 over LEN, TYPE and PAYLOAD
+ *
+ * 0xA5 never appears in ASCII telemetry, so the framer tells the two apart by
+ * the first byte of each frame.
+ *
+ * This file has no Arduino dependencies so the framer can be fed recorded
+ * byte streams on a desktop machine.
+ */
+
+#ifndef EXONAUT_FRAMER_H
+#define EXONAUT_FRAMER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+#define EXONAUT_RX_RING_SIZE 256 // must be a power of two
+#define EXONAUT_FRAME_MAX 63     // longest frame body accepted, '$' not included
+#define EXONAUT_FRAME_TERMINATOR '$'
+
+#define EXONAUT_BIN_SYNC 0xA5
+#define EXONAUT_BIN_PAYLOAD_MAX 32 // longest binary payload, TYPE not included
+#define EXONAUT_BIN_OVERHEAD 4     // sync, length, type and CRC bytes
+
+#define EXONAUT_FRAME_ASCII 0
+#define EXONAUT_FRAME_BINARY 1
+
+typedef struct __exonaut_frame_t
+{
+    const uint8_t *data; // frame body, valid until the next call to ExoNaut_Framer::next()
+    uint8_t len;         // ASCII: body length without '$'.  Binary: TYPE plus payload.
+    uint8_t format;      // EXONAUT_FRAME_ASCII or EXONAUT_FRAME_BINARY
+} exonaut_frame_t;
+
+// CRC-8, polynomial 0x07, initial value 0, as used by binary frames
+uint8_t exonaut_crc8(const uint8_t *data, size_t len, uint8_t crc = 0);
+
+class ExoNaut_RingBuffer
+{
+public:
+    ExoNaut_RingBuffer();
+
+    // Producer side
+    size_t writeSpan(uint8_t **ptr); // largest contiguous free region, returns its size
+    void commit(size_t n);           // publish n bytes written into the span
+    size_t write(const uint8_t *src, size_t n);
+
+    // Consumer side
+    size_t available(void) const;
+    uint8_t peek(size_t offset) const;
+    size_t readSpan(size_t offset, const uint8_t **ptr) const; // contiguous bytes starting at offset
+    void consume(size_t n);
+    void reset(void);
+
+private:
+    uint8_t buf[EXONAUT_RX_RING_SIZE];
+    std::atomic<uint32_t> head; // written only by the producer
+    std::atomic<uint32_t> tail; // written only by the consumer
+};
+
+class ExoNaut_Framer
+{
+public:
+    ExoNaut_Framer(ExoNaut_RingBuffer &ring);
+
+    // Returns the next complete frame.  The previous frame is released first,
+    // so a view stays valid until next() is called again.
+    bool next(exonaut_frame_t *frame);
+    void reset(void);
+
+    uint32_t dropped;    // oversize ASCII frames and debris skipped while resynchronising
+    uint32_t crc_errors; // binary frames discarded for a bad length or CRC
+
+private:
+    bool nextBinary(exonaut_frame_t *frame, bool *wait);
+    const uint8_t *view(size_t offset, size_t len);
+
+    ExoNaut_RingBuffer &ring;
+    size_t pending;  // bytes to release before scanning for the next frame
+    size_t scanned;  // bytes already searched for a terminator
+    bool discarding; // skipping an oversize frame up to its terminator
+    uint8_t scratch[EXONAUT_FRAME_MAX]; // only used when a frame wraps the ring
+};
+
+#endif // EXONAUT_FRAMER_H
@@ -0,0 +1,54 @@
+/*
+ * ExoNaut_Hex.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * Lookup table and run decoder for ExoNaut_Hex.h.
+ */
+
+#include "ExoNaut_Hex.h"
+
+#define HEX_ROW(b)                                                                                            \
+    exonaut_hex_nibble((b) + 0x0), exonaut_hex_nibble((b) + 0x1), exonaut_hex_nibble((b) + 0x2),              \
+        exonaut_hex_nibble((b) + 0x3), exonaut_hex_nibble((b) + 0x4), exonaut_hex_nibble((b) + 0x5),          \
+        exonaut_hex_nibble((b) + 0x6), exonaut_hex_nibble((b) + 0x7), exonaut_hex_nibble((b) + 0x8),          \
+        exonaut_hex_nibble((b) + 0x9), exonaut_hex_nibble((b) + 0xA), exonaut_hex_nibble((b) + 0xB),          \
+        exonaut_hex_nibble((b) + 0xC), exonaut_hex_nibble((b) + 0xD), exonaut_hex_nibble((b) + 0xE),          \
+        exonaut_hex_nibble((b) + 0xF)
+
+extern constexpr uint8_t exonaut_hex_lut[256] = {
+    HEX_ROW(0x00), HEX_ROW(0x10), HEX_ROW(0x20), HEX_ROW(0x30),
+    HEX_ROW(0x40), HEX_ROW(0x50), HEX_ROW(0x60), HEX_ROW(0x70),
+    HEX_ROW(0x80), HEX_ROW(0x90), HEX_ROW(0xA0), HEX_ROW(0xB0),
+    HEX_ROW(0xC0), HEX_ROW(0xD0), HEX_ROW(0xE0), HEX_ROW(0xF0),
+};
+
+static_assert(exonaut_hex_lut['7'] == 7 && exonaut_hex_lut['c'] == 12 && exonaut_hex_lut['G'] == EXONAUT_HEX_INVALID,
+              "hex lookup table");
+
+bool exonaut_hex_decode(const uint8_t *src, size_t nchars, uint8_t *dst, size_t *bad_pos)
+{
+    uint8_t invalid = 0;
+    size_t nbytes = nchars >> 1;
+    for (size_t i = 0; i < nbytes; ++i)
+    {
+        uint8_t hi = exonaut_hex_lut[src[2 * i]];
+        uint8_t lo = exonaut_hex_lut[src[2 * i + 1]];
+        invalid |= hi | lo; // only an invalid entry sets the upper nibble
+        dst[i] = (uint8_t)((hi << 4) | (lo & 0x0F));
+    }
+    if ((invalid & 0xF0) == 0 && (nchars & 1) == 0)
+    {
+        return true;
+    }
+    if (bad_pos != NULL)
+    {
+        size_t i = 0;
+        while (i < nchars && exonaut_hex_lut[src[i]] != EXONAUT_HEX_INVALID)
+        {
+            ++i;
+        }
+        *bad_pos = i; // == nchars for an odd length run
+    }
+    return false;
+}
@@ -0,0 +1,34 @@
+/*
+ * ExoNaut_Hex.h
+ *
+ * Date: October 16th, 2026
+ *
+ * Table driven hex decoding for the co-processor's ASCII telemetry.  Every
+ * character is one lookup in a 256 entry table built at compile time, and a
+ * whole run of digits is validated with a single test at the end.
+ */
+
+#ifndef EXONAUT_HEX_H
+#define EXONAUT_HEX_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define EXONAUT_HEX_INVALID 0xFF // table entry for anything that is not a hex digit
+
+constexpr uint8_t exonaut_hex_nibble(uint8_t ch)
+{
+    return (ch >= '0' && ch <= '9')   ? (uint8_t)(ch - '0')
+           : (ch >= 'A' && ch <= 'F') ? (uint8_t)(ch - 'A' + 10)
+           : (ch >= 'a' && ch <= 'f') ? (uint8_t)(ch - 'a' + 10)
+                                      : (uint8_t)EXONAUT_HEX_INVALID;
+}
+
+extern const uint8_t exonaut_hex_lut[256];
+
+// Decode nchars hex digits (two per byte, most significant first) into dst.
+// Returns false if any character is not a hex digit; bad_pos then receives
+// the index of the first offending character.  dst is undefined on failure.
+bool exonaut_hex_decode(const uint8_t *src, size_t nchars, uint8_t *dst, size_t *bad_pos = NULL);
+
+#endif // EXONAUT_HEX_H
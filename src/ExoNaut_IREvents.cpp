@@ -0,0 +1,86 @@
+/*
+ * ExoNaut_IREvents.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * IR key event engine for ExoNaut_IREvents.h.
+ */
+
+#include "ExoNaut_IREvents.h"
+
+ExoNaut_IREvents::ExoNaut_IREvents() : long_press_ms(IR_LONG_PRESS_MS), repeat_ms(IR_REPEAT_MS), debounce_ms(IR_DEBOUNCE_MS),
+                                       key(0), press_ms(0), repeat_at_ms(0), long_sent(false), release_pending(false), release_ms(0)
+{
+}
+
+void ExoNaut_IREvents::setTiming(uint16_t long_press_ms, uint16_t repeat_ms, uint16_t debounce_ms)
+{
+    this->long_press_ms = long_press_ms;
+    this->repeat_ms = repeat_ms;
+    this->debounce_ms = debounce_ms;
+}
+
+uint8_t ExoNaut_IREvents::update(uint16_t code, uint32_t now_ms, ir_event_t *events)
+{
+    uint8_t n = 0;
+
+    if (key != 0 && (code == 0 || code != key))
+    {
+        // A different key counts as an immediate release; 0 has to last debounce_ms
+        if (code == 0 && !release_pending)
+        {
+            release_pending = true;
+            release_ms = now_ms;
+        }
+        if (code != 0 || now_ms - release_ms >= debounce_ms)
+        {
+            events[n].ir_code = key;
+            events[n].event = long_sent ? IR_EVENT_LONG_RELEASE : IR_EVENT_RELEASE;
+            ++n;
+            key = 0;
+            release_pending = false;
+        }
+    }
+
+    if (code == 0)
+    {
+        return n;
+    }
+
+    if (key == 0)
+    {
+        key = code;
+        press_ms = now_ms;
+        long_sent = false;
+        events[n].ir_code = key;
+        events[n].event = IR_EVENT_PRESS;
+        ++n;
+        return n;
+    }
+
+    // Same key still held (a short dropout inside the debounce time is ignored)
+    release_pending = false;
+    if (!long_sent)
+    {
+        if (now_ms - press_ms >= long_press_ms)
+        {
+            long_sent = true;
+            repeat_at_ms = now_ms + repeat_ms;
+            events[n].ir_code = key;
+            events[n].event = IR_EVENT_LONG_PRESS;
+            ++n;
+        }
+    }
+    else if (repeat_ms != 0 && (int32_t)(now_ms - repeat_at_ms) >= 0)
+    {
+        repeat_at_ms += repeat_ms;
+        if ((int32_t)(now_ms - repeat_at_ms) >= 0)
+        {
+            repeat_at_ms = now_ms + repeat_ms; // frames stalled; don't burst to catch up
+        }
+        events[n].ir_code = key;
+        events[n].event = IR_EVENT_REPEAT;
+        ++n;
+    }
+    return n;
+}
@@ -0,0 +1,64 @@
+/*
+ * ExoNaut_IREvents.h
+ *
+ * Date: October 16th, 2026
+ *
+ * Turns the IR key code reported in the co-processor's 'A' frames into
+ * press, release, long press and auto-repeat events.  All timing is done in
+ * milliseconds from the frame timestamps, so it does not depend on how often
+ * frames arrive.
+ *
+ * This file has no Arduino dependencies so the engine can be driven from
+ * recorded frames on a desktop machine.
+ */
+
+#ifndef EXONAUT_IR_EVENTS_H
+#define EXONAUT_IR_EVENTS_H
+
+#include <stdint.h>
+
+// ir_event_t.event values
+#define IR_EVENT_PRESS 1
+#define IR_EVENT_RELEASE 2      // released before the long press time
+#define IR_EVENT_REPEAT 3       // key still held, sent every repeat interval after a long press
+#define IR_EVENT_LONG_PRESS 4
+#define IR_EVENT_LONG_RELEASE 5 // released after a long press
+
+#define IR_LONG_PRESS_MS 600 // default hold time for IR_EVENT_LONG_PRESS
+#define IR_REPEAT_MS 0       // default auto-repeat interval, 0 = off
+#define IR_DEBOUNCE_MS 60    // default time the key must read 0 before it counts as released
+#define IR_MAX_EVENTS 2      // most events a single update() can produce
+
+typedef struct __ir_event_t
+{
+    uint16_t ir_code;
+    int8_t event;
+} ir_event_t;
+
+class ExoNaut_IREvents
+{
+public:
+    ExoNaut_IREvents();
+
+    void setTiming(uint16_t long_press_ms, uint16_t repeat_ms, uint16_t debounce_ms);
+
+    // Feed the key code from one frame.  Writes up to IR_MAX_EVENTS events and
+    // returns how many.
+    uint8_t update(uint16_t code, uint32_t now_ms, ir_event_t *events);
+
+    uint16_t heldKey(void) const { return key; }
+
+private:
+    uint16_t long_press_ms;
+    uint16_t repeat_ms;
+    uint16_t debounce_ms;
+
+    uint16_t key; // key being held, 0 when none
+    uint32_t press_ms;
+    uint32_t repeat_at_ms;
+    bool long_sent;
+    bool release_pending;
+    uint32_t release_ms;
+};
+
+#endif // EXONAUT_IR_EVENTS_H
@@ -0,0 +1,409 @@
+/*
+ * ExoNaut_Motion.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * Implementation of the non-blocking motion planner and its segment queue.
+ */
+
+#include "ExoNaut_Motion.h"
+
+ExoNaut_Motion::ExoNaut_Motion() : _robot(nullptr), _control(nullptr), _task(NULL), _streamHz(0), _waiter(NULL), _stopping(false), _active(false),
+                                   _cancel(false), _head(0), _count(0), _nextId(0), _completed(0), _cb(nullptr), _cbArg(nullptr),
+                                   _shape(PROFILE_TRAPEZOID), _speed(MOTION_SPEED), _accel(MOTION_ACCEL),
+                                   _turnSpeed(MOTION_TURN_SPEED), _turnAccel(MOTION_TURN_ACCEL),
+                                   _dropCarry(false), _pos(0), _total(0)
+{
+    _mux = portMUX_INITIALIZER_UNLOCKED;
+    _current.id = 0;
+    _current.type = MOTION_SEG_WAIT;
+    _current.a = 0;
+    _current.b = 0;
+}
+
+bool ExoNaut_Motion::begin(exonaut *robot, ExoNaut_VelocityControl *control)
+{
+    if (robot == nullptr || _task != NULL)
+    {
+        return false;
+    }
+    _robot = robot;
+    _control = control;
+    _stopping = false;
+    _follower.dropCarry();
+    // Segments end on the measured counts, so keep them coming
+    if (!_robot->start_encoder_stream(MOTION_STREAM_HZ))
+    {
+        return false;
+    }
+    _streamHz = MOTION_STREAM_HZ;
+    if (xTaskCreatePinnedToCore(taskEntry, "motion", MOTION_TASK_STACK, this, 2, &_task, 0) != pdPASS)
+    {
+        _task = NULL;
+        _robot->stop_encoder_stream(_streamHz);
+        _streamHz = 0;
+        return false;
+    }
+    return true;
+}
+
+void ExoNaut_Motion::end(void)
+{
+    if (_task == NULL)
+    {
+        return;
+    }
+    clearQueue();
+    _stopping = true;
+    xTaskNotifyGive(_task);
+    while (_task != NULL)
+    {
+        delay(1); // the task clears _task on its way out
+    }
+    _robot->stop_encoder_stream(_streamHz); // other users keep their stream
+    _streamHz = 0;
+}
+
+void ExoNaut_Motion::setShape(uint8_t shape)
+{
+    _shape = shape;
+}
+
+void ExoNaut_Motion::setLimits(float speed_mm_s, float accel_mm_s2)
+{
+    _speed = speed_mm_s;
+    _accel = accel_mm_s2;
+}
+
+void ExoNaut_Motion::setTurnLimits(float speed_deg_s, float accel_deg_s2)
+{
+    _turnSpeed = speed_deg_s;
+    _turnAccel = accel_deg_s2;
+}
+
+bool ExoNaut_Motion::drive(float mm)
+{
+    return !busy() && queueDrive(mm) != 0;
+}
+
+bool ExoNaut_Motion::turn(float deg)
+{
+    return !busy() && queueTurn(deg) != 0;
+}
+
+bool ExoNaut_Motion::arc(float radius_mm, float deg)
+{
+    return radius_mm > 0 && !busy() && queueArc(radius_mm, deg) != 0;
+}
+
+uint32_t ExoNaut_Motion::queueDrive(float mm)
+{
+    return enqueue(MOTION_SEG_DRIVE, mm, 0);
+}
+
+uint32_t ExoNaut_Motion::queueTurn(float deg)
+{
+    return enqueue(MOTION_SEG_TURN, deg, 0);
+}
+
+uint32_t ExoNaut_Motion::queueArc(float radius_mm, float deg)
+{
+    return enqueue(MOTION_SEG_ARC, radius_mm, deg);
+}
+
+uint32_t ExoNaut_Motion::queueWait(uint32_t ms)
+{
+    return enqueue(MOTION_SEG_WAIT, (float)ms, 0);
+}
+
+uint32_t ExoNaut_Motion::queueSpeed(float speed_mm_s, float accel_mm_s2)
+{
+    return enqueue(MOTION_SEG_SPEED, speed_mm_s, accel_mm_s2);
+}
+
+void ExoNaut_Motion::onSegment(motion_callback_t cb, void *arg)
+{
+    portENTER_CRITICAL(&_mux);
+    _cb = cb;
+    _cbArg = arg;
+    portEXIT_CRITICAL(&_mux);
+}
+
+uint32_t ExoNaut_Motion::enqueue(uint8_t type, float a, float b)
+{
+    if (_task == NULL)
+    {
+        return 0;
+    }
+    uint32_t id = 0;
+    portENTER_CRITICAL(&_mux);
+    if (_count < MOTION_QUEUE_LEN)
+    {
+        id = ++_nextId;
+        if (id == 0)
+        {
+            id = ++_nextId; // 0 means "not queued"
+        }
+        motion_segment_t *seg = &_queue[(_head + _count) % MOTION_QUEUE_LEN];
+        seg->id = id;
+        seg->type = type;
+        seg->a = a;
+        seg->b = b;
+        ++_count;
+    }
+    portEXIT_CRITICAL(&_mux);
+    if (id != 0)
+    {
+        xTaskNotifyGive(_task);
+    }
+    return id;
+}
+
+bool ExoNaut_Motion::pop(motion_segment_t *segment)
+{
+    bool got = false;
+    portENTER_CRITICAL(&_mux);
+    if (_count > 0 && !_stopping)
+    {
+        *segment = _queue[_head];
+        _head = (_head + 1) % MOTION_QUEUE_LEN;
+        --_count;
+        _active = true; // set together with the pop so busy() never sees a gap
+        _cancel = false;
+        got = true;
+    }
+    portEXIT_CRITICAL(&_mux);
+    return got;
+}
+
+bool ExoNaut_Motion::busy(void) const
+{
+    return _active || _count > 0;
+}
+
+uint8_t ExoNaut_Motion::queued(void)
+{
+    return _count;
+}
+
+bool ExoNaut_Motion::peek(uint8_t index, motion_segment_t *segment)
+{
+    bool got = false;
+    portENTER_CRITICAL(&_mux);
+    if (index < _count)
+    {
+        *segment = _queue[(_head + index) % MOTION_QUEUE_LEN];
+        got = true;
+    }
+    portEXIT_CRITICAL(&_mux);
+    return got;
+}
+
+void ExoNaut_Motion::cancel(void)
+{
+    if (_active)
+    {
+        _cancel = true;
+        xTaskNotifyGive(_task);
+    }
+}
+
+void ExoNaut_Motion::clearQueue(void)
+{
+    portENTER_CRITICAL(&_mux);
+    _count = 0;
+    portEXIT_CRITICAL(&_mux);
+    _dropCarry = true;
+    cancel();
+}
+
+bool ExoNaut_Motion::wait(uint32_t timeout_ms)
+{
+    uint32_t start = millis();
+    _waiter = xTaskGetCurrentTaskHandle();
+    while (busy() && (timeout_ms == 0xFFFFFFFF || millis() - start < timeout_ms))
+    {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(MOTION_TICK_MS)); // woken as segments finish
+    }
+    _waiter = NULL;
+    return !busy();
+}
+
+float ExoNaut_Motion::progress(void) const
+{
+    float total = _total;
+    return total != 0 ? _pos / total : 1.0f;
+}
+
+void ExoNaut_Motion::output(float v_mm_s, float w_rad_s)
+{
+    float track;
+    _robot->get_wheel_geometry(NULL, &track);
+    float left = v_mm_s - w_rad_s * track * 0.5f;
+    float right = v_mm_s + w_rad_s * track * 0.5f;
+    if (_control != nullptr && _control->running())
+    {
+        _control->setSpeed(left, right);
+        return;
+    }
+    float radius;
+    _robot->get_wheel_geometry(&radius, NULL);
+    float scale = 60.0f / (2.0f * PI * radius) / EXONAUT_RPM_PER_SPEED; // mm/s to set_motor_speed() units
+    _robot->set_motor_speed(left * scale, right * scale);
+}
+
+void ExoNaut_Motion::halt(void)
+{
+    if (_control != nullptr && _control->running())
+    {
+        _control->stop();
+    }
+    else
+    {
+        _robot->stop_motor(0);
+    }
+}
+
+void ExoNaut_Motion::taskEntry(void *arg)
+{
+    ((ExoNaut_Motion *)arg)->run();
+}
+
+void ExoNaut_Motion::run(void)
+{
+    motion_segment_t seg;
+    while (!_stopping)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        while (pop(&seg))
+        {
+            _current = seg;
+            uint8_t result = execute(&seg);
+            ++_completed;
+
+            motion_callback_t cb;
+            void *cb_arg;
+            portENTER_CRITICAL(&_mux);
+            cb = _cb;
+            cb_arg = _cbArg;
+            if (_count == 0)
+            {
+                _active = false;
+            }
+            portEXIT_CRITICAL(&_mux);
+            if (cb != nullptr)
+            {
+                cb(&seg, result, cb_arg);
+            }
+            TaskHandle_t waiter = _waiter;
+            if (waiter != NULL)
+            {
+                xTaskNotifyGive(waiter);
+            }
+        }
+        _follower.release(); // the next segment starts from wherever the robot is by then
+        _active = false;
+    }
+    _task = NULL;
+    vTaskDelete(NULL);
+}
+
+uint8_t ExoNaut_Motion::execute(const motion_segment_t *seg)
+{
+    switch (seg->type)
+    {
+    case MOTION_SEG_DRIVE:
+        return runProfile(seg->a, _speed, _accel, 1.0f, 0, MOTION_TOLERANCE_MM);
+    case MOTION_SEG_TURN:
+        return runProfile(seg->a, _turnSpeed, _turnAccel, 0, DEG_TO_RAD, MOTION_TOLERANCE_DEG);
+    case MOTION_SEG_ARC:
+        if (seg->a <= 0)
+        {
+            return MOTION_INVALID;
+        }
+        // Plan the distance along the centre line; the turn rate follows from it
+        return runProfile(seg->a * fabsf(seg->b) * DEG_TO_RAD, _speed, _accel, 1.0f, (seg->b < 0 ? -1.0f : 1.0f) / seg->a, MOTION_TOLERANCE_MM);
+    case MOTION_SEG_WAIT:
+    {
+        TickType_t begin = xTaskGetTickCount();
+        TickType_t length = pdMS_TO_TICKS((uint32_t)seg->a);
+        _pos = 0;
+        _total = seg->a;
+        while (xTaskGetTickCount() - begin < length)
+        {
+            if (_cancel || _stopping)
+            {
+                return MOTION_CANCELLED;
+            }
+            TickType_t left = length - (xTaskGetTickCount() - begin);
+            ulTaskNotifyTake(pdTRUE, left < pdMS_TO_TICKS(MOTION_TICK_MS) ? left : pdMS_TO_TICKS(MOTION_TICK_MS));
+            _pos = (float)((xTaskGetTickCount() - begin) * portTICK_PERIOD_MS);
+        }
+        _pos = _total;
+        return MOTION_DONE;
+    }
+    case MOTION_SEG_SPEED:
+        if (seg->a <= 0 || seg->b < 0)
+        {
+            return MOTION_INVALID;
+        }
+        _speed = seg->a;
+        if (seg->b > 0)
+        {
+            _accel = seg->b;
+        }
+        _pos = _total = 0;
+        return MOTION_DONE;
+    default:
+        return MOTION_INVALID;
+    }
+}
+
+uint8_t ExoNaut_Motion::runProfile(float distance, float speed, float accel, float kv, float kw, float tolerance)
+{
+    if (_dropCarry)
+    {
+        _dropCarry = false;
+        _follower.dropCarry();
+    }
+    float radius, track;
+    _robot->get_wheel_geometry(&radius, &track);
+    _follower.setGeometry(radius, track, encoder_motor.pulse_p_r);
+    if (!_follower.start(distance, speed, accel, _shape, kv, kw, tolerance, MOTION_SETTLE_MS))
+    {
+        return MOTION_INVALID;
+    }
+    _pos = 0;
+    _total = _follower.goal();
+
+    uint8_t result = MOTION_DONE;
+    TickType_t begin = xTaskGetTickCount();
+    TickType_t wake = begin;
+    for (;;)
+    {
+        if (_cancel || _stopping)
+        {
+            result = MOTION_CANCELLED;
+            break;
+        }
+        float t = (float)((xTaskGetTickCount() - begin) * portTICK_PERIOD_MS) * 0.001f;
+        encoder_snapshot_t snap;
+        _robot->get_encoder_snapshot(&snap);
+        float v, w;
+        uint8_t state = _follower.update(t, snap.count_1, snap.count_2, &v, &w);
+        _pos = _follower.progress();
+        if (state != FOLLOW_RUNNING)
+        {
+            result = state == FOLLOW_DONE ? MOTION_DONE : MOTION_TIMEOUT;
+            break;
+        }
+        output(v, w);
+        vTaskDelayUntil(&wake, pdMS_TO_TICKS(MOTION_TICK_MS));
+    }
+    halt();
+    if (result == MOTION_CANCELLED)
+    {
+        _follower.dropCarry(); // a cancelled segment's error is not made up
+    }
+    return result;
+}
@@ -0,0 +1,164 @@
+/*
+ * ExoNaut_Motion.h
+ *
+ * Date: October 16th, 2026
+ *
+ * Non-blocking motion planner for the ExoNaut.  Straight moves, turns on the
+ * spot and arcs are planned as trapezoidal or S-curve velocity profiles (see
+ * ExoNaut_Profile.h) and played out by a task on core 0 at a fixed tick, so
+ * acceleration stays bounded and loop() is free while the robot moves:
+ *
+ *   ExoNaut_Motion motion;
+ *   motion.begin(&robot);
+ *   motion.drive(300);  // 300 mm forwards
+ *   while (motion.busy()) { ...read sensors... }
+ *   motion.turn(90);    // quarter turn to the left
+ *   motion.wait();
+ *
+ * Moves can also be queued as a script that runs back to back without any
+ * delay() in the sketch.  Every queued segment gets an id, and a callback
+ * reports each one as it finishes:
+ *
+ *   motion.queueDrive(500);
+ *   motion.queueTurn(-90);
+ *   motion.queueWait(1000);
+ *   motion.queueArc(200, 180);
+ *
+ * Each drive, turn or arc is closed on the encoders (ExoNaut_SegmentFollower.h):
+ * the wheels are steered back onto the profile as they go, and the segment
+ * ends when the measured distance or heading reaches the target, or with
+ * MOTION_TIMEOUT when it still has not MOTION_SETTLE_MS after the profile
+ * ended.  What a finished segment is left short or past by is made up by the
+ * next one: distance by a drive or arc straight after it, heading by whichever
+ * segment comes next.  A timed out segment leaves nothing over, as whatever
+ * held the robot back may still be there; progress() shows how far it got and
+ * the sketch decides what to do about the rest.  cancel() and clearQueue()
+ * drop it as well.
+ *
+ * Wheel speeds go to an ExoNaut_VelocityControl when one is given to begin(),
+ * which keeps the robot on the profile regardless of battery and load;
+ * otherwise they are converted with the open loop set_motor_speed() scale.
+ */
+
+#ifndef EXONAUT_MOTION_H
+#define EXONAUT_MOTION_H
+
+#include <Arduino.h>
+#include "ExoNaut.h"
+#include "ExoNaut_Profile.h"
+#include "ExoNaut_SegmentFollower.h"
+#include "ExoNaut_VelocityControl.h"
+
+#define MOTION_TICK_MS 20          // profile sample period
+#define MOTION_SPEED 150.0f        // default speed limit, mm/s
+#define MOTION_ACCEL 300.0f        // default acceleration limit, mm/s^2
+#define MOTION_TURN_SPEED 90.0f    // default turn rate limit, deg/s
+#define MOTION_TURN_ACCEL 180.0f   // default turn acceleration limit, deg/s^2
+#define MOTION_TASK_STACK 3072
+#define MOTION_QUEUE_LEN 16        // segments that can wait behind the running one
+#define MOTION_STREAM_HZ 50        // encoder rate claimed while begun; a faster stream keeps its rate
+#define MOTION_TOLERANCE_MM 2.0f   // drives and arcs end this close to the target distance
+#define MOTION_TOLERANCE_DEG 1.0f  // turns end this close to the target heading
+#define MOTION_SETTLE_MS 1000      // time allowed after the profile to reach the target
+
+// Segment types
+#define MOTION_SEG_DRIVE 0 // a = mm
+#define MOTION_SEG_TURN 1  // a = degrees, positive left
+#define MOTION_SEG_ARC 2   // a = radius mm, b = degrees, positive left
+#define MOTION_SEG_WAIT 3  // a = ms
+#define MOTION_SEG_SPEED 4 // a = mm/s, b = mm/s^2 (0 keeps the current acceleration)
+
+// Segment results
+#define MOTION_DONE 0
+#define MOTION_CANCELLED 1 // stopped by cancel() or clearQueue()
+#define MOTION_INVALID 2   // parameters could not be planned
+#define MOTION_TIMEOUT 3   // the encoders had not reached the target after the settle time
+
+typedef struct __motion_segment_t
+{
+    uint32_t id; // increases by one for every queued segment, never 0
+    uint8_t type;
+    float a;
+    float b;
+} motion_segment_t;
+
+// Called from the motion task after each segment; must return quickly
+typedef void (*motion_callback_t)(const motion_segment_t *segment, uint8_t result, void *arg);
+
+class ExoNaut_Motion
+{
+public:
+    ExoNaut_Motion();
+
+    bool begin(exonaut *robot, ExoNaut_VelocityControl *control = nullptr);
+    void end(void);
+
+    void setShape(uint8_t shape); // PROFILE_TRAPEZOID or PROFILE_SCURVE
+    void setLimits(float speed_mm_s, float accel_mm_s2);
+    void setTurnLimits(float speed_deg_s, float accel_deg_s2);
+
+    // Single moves; each returns false while anything is running or queued
+    bool drive(float mm);                 // negative drives backwards
+    bool turn(float deg);                 // on the spot, positive turns left
+    bool arc(float radius_mm, float deg); // forwards along a circle, positive turns left
+
+    // Script: each returns the segment id, or 0 when the queue is full
+    uint32_t queueDrive(float mm);
+    uint32_t queueTurn(float deg);
+    uint32_t queueArc(float radius_mm, float deg);
+    uint32_t queueWait(uint32_t ms);
+    uint32_t queueSpeed(float speed_mm_s, float accel_mm_s2 = 0); // limits for the segments after it
+    void onSegment(motion_callback_t cb, void *arg);
+
+    // Progress
+    bool busy(void) const;
+    bool wait(uint32_t timeout_ms = 0xFFFFFFFF); // false if still running at the timeout
+    float progress(void) const;   // 0 to 1 through the current or last segment
+    uint32_t currentId(void) const { return _current.id; } // running or last finished segment
+    uint8_t queued(void);         // segments waiting behind the running one
+    bool peek(uint8_t index, motion_segment_t *segment); // index 0 runs next
+    uint32_t completed(void) const { return _completed; }
+
+    void cancel(void);     // stop the running segment at once, the queue carries on
+    void clearQueue(void); // drop everything queued and stop
+
+private:
+    static void taskEntry(void *arg);
+    void run(void);
+    uint32_t enqueue(uint8_t type, float a, float b);
+    bool pop(motion_segment_t *segment);
+    uint8_t execute(const motion_segment_t *segment);
+    uint8_t runProfile(float distance, float speed, float accel, float kv, float kw, float tolerance);
+    void output(float v_mm_s, float w_rad_s);
+    void halt(void);
+
+    exonaut *_robot;
+    ExoNaut_VelocityControl *_control;
+    TaskHandle_t _task;
+    uint16_t _streamHz; // rate claimed from start_encoder_stream()
+    volatile TaskHandle_t _waiter;
+    volatile bool _stopping;
+    volatile bool _active; // a segment is running
+    volatile bool _cancel;
+    portMUX_TYPE _mux;
+
+    motion_segment_t _queue[MOTION_QUEUE_LEN];
+    uint8_t _head;
+    uint8_t _count;
+    uint32_t _nextId;
+    volatile uint32_t _completed;
+    motion_segment_t _current;
+    motion_callback_t _cb;
+    void *_cbArg;
+
+    uint8_t _shape;
+    float _speed, _accel;
+    float _turnSpeed, _turnAccel;
+
+    ExoNaut_SegmentFollower _follower;
+    volatile bool _dropCarry; // set by clearQueue(), so the next segment starts clean
+    volatile float _pos;   // progress through the running segment
+    volatile float _total; // mm, degrees or ms
+};
+
+#endif // EXONAUT_MOTION_H
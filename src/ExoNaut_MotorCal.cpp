@@ -0,0 +1,151 @@
+/*
+ * ExoNaut_MotorCal.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * Implementation of the per wheel speed calibration fit.
+ */
+
+#include "ExoNaut_MotorCal.h"
+#include <math.h>
+#include <stddef.h>
+
+ExoNaut_MotorCal::ExoNaut_MotorCal()
+{
+    reset();
+}
+
+void ExoNaut_MotorCal::reset(void)
+{
+    for (int w = 0; w < 2; w++)
+    {
+        count[w][0] = 0;
+        count[w][1] = 0;
+    }
+}
+
+bool ExoNaut_MotorCal::addSample(uint8_t wheel, int8_t byte, float measured)
+{
+    if (wheel > 1 || byte == 0)
+    {
+        return false;
+    }
+    uint8_t dir = byte < 0 ? 0 : 1;
+    uint8_t n = count[wheel][dir];
+    if (n >= MOTOR_CAL_MAX_POINTS)
+    {
+        return false;
+    }
+    bytes[wheel][dir][n] = (uint8_t)(byte < 0 ? -byte : byte);
+    rpm[wheel][dir][n] = dir == 0 ? measured : -measured; // turning the wrong way counts as negative
+    count[wheel][dir] = n + 1;
+    return true;
+}
+
+bool ExoNaut_MotorCal::fit(motor_cal_t *cal, uint8_t motor_type) const
+{
+    cal->magic = MOTOR_CAL_MAGIC;
+    cal->version = MOTOR_CAL_VERSION;
+    cal->motor_type = motor_type;
+    for (int w = 0; w < 2; w++)
+    {
+        for (int d = 0; d < 2; d++)
+        {
+            // Least squares line through the samples where the wheel turned
+            float sx = 0, sy = 0, sxx = 0, sxy = 0;
+            uint8_t n = 0;
+            uint8_t deadband = 0xFF;
+            for (uint8_t i = 0; i < count[w][d]; i++)
+            {
+                float y = rpm[w][d][i];
+                if (y < MOTOR_CAL_MOVING_RPM)
+                {
+                    continue;
+                }
+                float x = bytes[w][d][i];
+                sx += x;
+                sy += y;
+                sxx += x * x;
+                sxy += x * y;
+                ++n;
+                if (bytes[w][d][i] < deadband)
+                {
+                    deadband = bytes[w][d][i];
+                }
+            }
+            float den = n * sxx - sx * sx;
+            if (n < 2 || den <= 0)
+            {
+                return false;
+            }
+            motor_cal_fit_t *f = &cal->fit[w][d];
+            f->gain = (n * sxy - sx * sy) / den;
+            f->offset = (sy - f->gain * sx) / n;
+            f->deadband = deadband;
+            if (f->gain <= 0)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool exonaut_motorcal_valid(const motor_cal_t *cal)
+{
+    if (cal->magic != MOTOR_CAL_MAGIC || cal->version != MOTOR_CAL_VERSION)
+    {
+        return false;
+    }
+    for (int w = 0; w < 2; w++)
+    {
+        for (int d = 0; d < 2; d++)
+        {
+            if (!(cal->fit[w][d].gain > 0) || cal->fit[w][d].deadband == 0)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int8_t exonaut_speed_byte_default(float speed)
+{
+    float rpm = speed / 55.0f * 90.0f;
+    float pps = (-rpm / 60.0f) * 680.0f;
+    return (int8_t)(int)roundf(pps * 0.01f);
+}
+
+int8_t exonaut_motorcal_byte(const motor_cal_t *cal, uint8_t wheel, float rpm)
+{
+    if (rpm == 0 || wheel > 1)
+    {
+        return 0;
+    }
+    uint8_t dir = rpm > 0 ? 0 : 1;
+    const motor_cal_fit_t *f = &cal->fit[wheel][dir];
+    float mag = fabsf(rpm);
+    float b = roundf((mag - f->offset) / f->gain);
+    if (b < f->deadband)
+    {
+        // Below the deadband the wheel would not turn at all; jump over it
+        // unless the request is closer to standing still
+        float slowest = f->gain * f->deadband + f->offset;
+        b = mag >= 0.5f * slowest ? f->deadband : 0;
+    }
+    if (b > 127)
+    {
+        b = 127;
+    }
+    return dir == 0 ? (int8_t)-b : (int8_t)b;
+}
+
+int8_t exonaut_speed_byte(const motor_cal_t *cal, uint8_t wheel, float speed)
+{
+    if (cal == NULL)
+    {
+        return exonaut_speed_byte_default(speed);
+    }
+    return exonaut_motorcal_byte(cal, wheel, speed / 55.0f * 90.0f); // EXONAUT_RPM_PER_SPEED
+}
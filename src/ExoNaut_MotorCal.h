@@ -0,0 +1,75 @@
+/*
+ * ExoNaut_MotorCal.h
+ *
+ * Date: October 16th, 2026
+ *
+ * Per wheel speed calibration.  set_motor_speed() normally turns a speed into
+ * the co-processor's speed byte with one fixed formula for both wheels.  A
+ * calibration sweep sends a range of speed bytes in each direction, measures
+ * the wheel speed from the encoders and fits, for every wheel and direction:
+ *
+ *   |rpm| = gain * |byte| + offset      for |byte| >= deadband
+ *
+ * where deadband is the smallest byte that turned the wheel.  Inverting the fit
+ * gives the byte for a requested speed, so both wheels reach the same rpm for
+ * the same command.  Positive speeds use negative bytes, as in
+ * encoder_motor_set_speed_base().
+ *
+ * This file has no Arduino dependencies so a sweep can be fitted from recorded
+ * samples on a desktop machine.
+ */
+
+#ifndef EXONAUT_MOTORCAL_H
+#define EXONAUT_MOTORCAL_H
+
+#include <stdint.h>
+
+#define MOTOR_CAL_MAGIC 0x4D43
+#define MOTOR_CAL_VERSION 1
+#define MOTOR_CAL_MAX_POINTS 32  // samples kept per wheel and direction
+#define MOTOR_CAL_SWEEP_MAX 18   // default largest byte swept, about set_motor_speed(100)
+#define MOTOR_CAL_MOVING_RPM 2.0f // slower than this counts as not turning
+
+typedef struct __motor_cal_fit_t
+{
+    float gain;       // rpm per unit of the speed byte
+    float offset;     // rpm
+    uint8_t deadband; // smallest byte that turns the wheel
+} motor_cal_fit_t;
+
+typedef struct __motor_cal_t
+{
+    uint16_t magic;     // MOTOR_CAL_MAGIC
+    uint8_t version;    // MOTOR_CAL_VERSION
+    uint8_t motor_type; // set_motor_type() the sweep was run with
+    motor_cal_fit_t fit[2][2]; // [wheel][0 forwards, 1 backwards]
+} motor_cal_t;
+
+class ExoNaut_MotorCal
+{
+public:
+    ExoNaut_MotorCal();
+
+    void reset(void);
+    // wheel 0 or 1; byte as sent; rpm measured, positive forwards
+    bool addSample(uint8_t wheel, int8_t byte, float rpm);
+    // False if a wheel did not turn at two or more bytes in both directions
+    bool fit(motor_cal_t *cal, uint8_t motor_type) const;
+
+private:
+    uint8_t count[2][2];
+    uint8_t bytes[2][2][MOTOR_CAL_MAX_POINTS];
+    float rpm[2][2][MOTOR_CAL_MAX_POINTS];
+};
+
+bool exonaut_motorcal_valid(const motor_cal_t *cal);
+// Speed byte for speed in set_motor_speed() units with the fixed mapping used
+// when there is no calibration
+int8_t exonaut_speed_byte_default(float speed);
+// Speed byte for wheel 0 or 1 to turn at rpm (positive forwards)
+int8_t exonaut_motorcal_byte(const motor_cal_t *cal, uint8_t wheel, float rpm);
+// Speed byte for wheel 0 or 1 at speed in set_motor_speed() units, through the
+// fit when cal is not NULL and the fixed mapping otherwise
+int8_t exonaut_speed_byte(const motor_cal_t *cal, uint8_t wheel, float speed);
+
+#endif // EXONAUT_MOTORCAL_H
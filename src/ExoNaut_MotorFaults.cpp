@@ -0,0 +1,151 @@
+/*
+ * ExoNaut_MotorFaults.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * Implementation of the wheel stall, slip and lift classifiers.
+ */
+
+#include "ExoNaut_MotorFaults.h"
+#include <math.h>
+
+#define MONITOR_FILTER 0.4f // weight of the newest speed measurement
+
+ExoNaut_MotorFaults::ExoNaut_MotorFaults() : have_prev(false), stall_ratio(MONITOR_STALL_RATIO), slip_ratio(MONITOR_SLIP_RATIO),
+                                             lift_ratio(MONITOR_LIFT_RATIO), min_rpm(MONITOR_MIN_RPM),
+                                             settle_ms(MONITOR_SETTLE_MS), hold_ms(MONITOR_HOLD_MS)
+{
+    for (int i = 0; i < 2; i++)
+    {
+        commanded[i] = 0;
+        command_us[i] = 0;
+        rpm[i] = 0;
+        candidate[i] = MOTOR_OK;
+        since_us[i] = 0;
+        was_latched[i] = false;
+        faults[i] = MOTOR_OK;
+        is_latched[i] = false;
+    }
+}
+
+void ExoNaut_MotorFaults::setThresholds(float stall_ratio, float slip_ratio, float lift_ratio, float min_rpm)
+{
+    this->stall_ratio = stall_ratio;
+    this->slip_ratio = slip_ratio;
+    this->lift_ratio = lift_ratio;
+    this->min_rpm = min_rpm;
+}
+
+void ExoNaut_MotorFaults::setTiming(uint16_t settle_ms, uint16_t hold_ms)
+{
+    this->settle_ms = settle_ms;
+    this->hold_ms = hold_ms;
+}
+
+void ExoNaut_MotorFaults::restart(void)
+{
+    have_prev = false;
+}
+
+void ExoNaut_MotorFaults::latch(uint8_t wheel)
+{
+    is_latched[wheel] = true;
+    was_latched[wheel] = true;
+}
+
+void ExoNaut_MotorFaults::clear(uint8_t wheel)
+{
+    is_latched[wheel] = false; // the next update() starts the wheel over
+}
+
+bool ExoNaut_MotorFaults::judged(uint8_t i, uint32_t now_us) const
+{
+    return fabsf(commanded[i]) >= min_rpm && now_us - command_us[i] >= settle_ms * 1000UL;
+}
+
+uint8_t ExoNaut_MotorFaults::update(const encoder_snapshot_t *snap, float pulses_per_rev, const float command[2])
+{
+    if (!have_prev || snap->seq != prev.seq + 1)
+    {
+        prev = *snap; // need two consecutive frames for a speed
+        have_prev = true;
+        return 0;
+    }
+    uint32_t dt_us = snap->timestamp_us - prev.timestamp_us;
+    if (dt_us == 0)
+    {
+        return 0;
+    }
+    float scale = 60.0e6f / (pulses_per_rev * (float)dt_us);
+    float frame_rpm[2] = {(snap->count_1 - prev.count_1) * scale, (snap->count_2 - prev.count_2) * scale};
+    uint32_t now_us = snap->timestamp_us;
+    prev = *snap;
+
+    uint8_t seen[2];
+    for (int i = 0; i < 2; i++)
+    {
+        rpm[i] += (frame_rpm[i] - rpm[i]) * MONITOR_FILTER;
+        if (fabsf(command[i] - commanded[i]) > 0.5f)
+        {
+            commanded[i] = command[i];
+            command_us[i] = now_us;
+        }
+        seen[i] = MOTOR_OK;
+        if (!judged(i, now_us))
+        {
+            continue;
+        }
+        float ratio = rpm[i] / commanded[i]; // negative when turning the wrong way
+        if (ratio < stall_ratio)
+        {
+            seen[i] = MOTOR_STALL;
+        }
+        else if (ratio > 1.0f + lift_ratio)
+        {
+            seen[i] = MOTOR_LIFT;
+        }
+    }
+
+    // Slip: the wheels disagree with the commanded ratio and neither is stalled or lifted
+    if (seen[0] == MOTOR_OK && seen[1] == MOTOR_OK && judged(0, now_us) && judged(1, now_us))
+    {
+        float r0 = rpm[0] / commanded[0];
+        float r1 = rpm[1] / commanded[1];
+        if (fabsf(r0 - r1) > slip_ratio)
+        {
+            seen[r0 > r1 ? 0 : 1] = MOTOR_SLIP;
+        }
+    }
+
+    uint8_t changed = 0;
+    for (int i = 0; i < 2; i++)
+    {
+        if (is_latched[i])
+        {
+            continue;
+        }
+        if (was_latched[i])
+        {
+            // Cleared since the last frame: judge the wheel afresh
+            was_latched[i] = false;
+            candidate[i] = MOTOR_OK;
+            since_us[i] = now_us;
+            if (faults[i] != MOTOR_OK)
+            {
+                faults[i] = MOTOR_OK;
+                changed |= 1 << i;
+            }
+        }
+        if (seen[i] != candidate[i])
+        {
+            candidate[i] = seen[i];
+            since_us[i] = now_us;
+        }
+        if (seen[i] != faults[i] && (seen[i] == MOTOR_OK || now_us - since_us[i] >= hold_ms * 1000UL))
+        {
+            faults[i] = seen[i];
+            changed |= 1 << i;
+        }
+    }
+    return changed;
+}
@@ -0,0 +1,83 @@
+/*
+ * ExoNaut_MotorFaults.h
+ *
+ * Date: October 16th, 2026
+ *
+ * The stall, lift and slip classifiers behind ExoNaut_MotorMonitor.  Each
+ * encoder frame gives every wheel a speed, filtered, which is judged against
+ * the wheel's commanded speed:
+ *
+ *   STALL  the wheel turns at less than stall_ratio of its command
+ *   LIFT   the wheel turns faster than its command by more than lift_ratio
+ *   SLIP   the two wheels disagree with the commanded ratio between them by
+ *          more than slip_ratio; the faster wheel is flagged
+ *
+ * Commands slower than min_rpm, or changed less than the settle time ago, are
+ * not judged.  A condition becomes the wheel's fault once it has lasted for
+ * the hold time.  A latched wheel keeps its fault and is not judged again
+ * until clear(); it then starts over from MOTOR_OK.
+ *
+ * update() runs on one task (rx_task, from an encoder listener); clear() and
+ * the getters may be called from any task.  This file has no Arduino
+ * dependencies so recorded frames can be classified on a desktop machine.
+ */
+
+#ifndef EXONAUT_MOTORFAULTS_H
+#define EXONAUT_MOTORFAULTS_H
+
+#include <stdint.h>
+#include "ExoNaut_Telemetry.h"
+
+#define MOTOR_OK 0
+#define MOTOR_STALL 1
+#define MOTOR_SLIP 2
+#define MOTOR_LIFT 3
+
+#define MONITOR_MIN_RPM 10.0f      // commands slower than this are not judged
+#define MONITOR_SETTLE_MS 300      // time a new command gets to take effect
+#define MONITOR_HOLD_MS 400        // time a condition must last to be reported
+#define MONITOR_STALL_RATIO 0.25f
+#define MONITOR_LIFT_RATIO 0.3f
+#define MONITOR_SLIP_RATIO 0.35f
+
+class ExoNaut_MotorFaults
+{
+public:
+    ExoNaut_MotorFaults();
+
+    void setThresholds(float stall_ratio, float slip_ratio, float lift_ratio, float min_rpm = MONITOR_MIN_RPM);
+    void setTiming(uint16_t settle_ms, uint16_t hold_ms);
+    void restart(void); // the next frame starts a new speed measurement
+
+    // One encoder frame; command in rpm for wheels 0 and 1, positive forwards.
+    // Returns bit (1 << wheel) for every wheel whose fault() changed.
+    uint8_t update(const encoder_snapshot_t *snap, float pulses_per_rev, const float command[2]);
+
+    void latch(uint8_t wheel); // from update()'s caller only
+    void clear(uint8_t wheel);
+    bool latched(uint8_t wheel) const { return is_latched[wheel]; }
+
+    uint8_t fault(uint8_t wheel) const { return faults[wheel]; }
+    float measured(uint8_t wheel) const { return rpm[wheel]; } // filtered rpm
+    float command(uint8_t wheel) const { return commanded[wheel]; }
+
+private:
+    bool judged(uint8_t i, uint32_t now_us) const;
+
+    bool have_prev;
+    encoder_snapshot_t prev;
+
+    float stall_ratio, slip_ratio, lift_ratio, min_rpm;
+    uint16_t settle_ms, hold_ms;
+
+    float commanded[2];     // rpm
+    uint32_t command_us[2]; // when the command last changed
+    float rpm[2];           // measured, filtered
+    uint8_t candidate[2];   // condition seen in the latest frame
+    uint32_t since_us[2];   // when the candidate first appeared
+    bool was_latched[2];    // latched as of the last update()
+    volatile uint8_t faults[2];
+    volatile bool is_latched[2];
+};
+
+#endif // EXONAUT_MOTORFAULTS_H
@@ -0,0 +1,134 @@
+/*
+ * ExoNaut_MotorMonitor.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * Implementation of the wheel stall, slip and lift monitor.
+ */
+
+#include "ExoNaut_MotorMonitor.h"
+
+ExoNaut_MotorMonitor::ExoNaut_MotorMonitor() : _robot(nullptr), _running(false), _streamHz(0), _cutMask(MONITOR_CUT_MASK),
+                                               _cb(nullptr), _cbArg(nullptr)
+{
+}
+
+bool ExoNaut_MotorMonitor::begin(exonaut *robot, uint16_t rate_hz)
+{
+    if (robot == nullptr || _running)
+    {
+        return false;
+    }
+    _robot = robot;
+    _faults.restart();
+    if (!_robot->add_encoder_listener(onEncoder, this))
+    {
+        return false;
+    }
+    if (!_robot->start_encoder_stream(rate_hz))
+    {
+        _robot->remove_encoder_listener(onEncoder, this);
+        return false;
+    }
+    _streamHz = rate_hz;
+    _running = true;
+    return true;
+}
+
+void ExoNaut_MotorMonitor::end(void)
+{
+    if (!_running)
+    {
+        return;
+    }
+    _robot->remove_encoder_listener(onEncoder, this);
+    _robot->stop_encoder_stream(_streamHz);
+    _streamHz = 0;
+    _running = false;
+}
+
+void ExoNaut_MotorMonitor::setThresholds(float stall_ratio, float slip_ratio, float lift_ratio, float min_rpm)
+{
+    _faults.setThresholds(stall_ratio, slip_ratio, lift_ratio, min_rpm);
+}
+
+void ExoNaut_MotorMonitor::setTiming(uint16_t settle_ms, uint16_t hold_ms)
+{
+    _faults.setTiming(settle_ms, hold_ms);
+}
+
+void ExoNaut_MotorMonitor::setCutMask(uint8_t mask)
+{
+    _cutMask = mask;
+}
+
+void ExoNaut_MotorMonitor::onFault(motor_fault_callback_t cb, void *arg)
+{
+    _cb = nullptr;
+    _cbArg = arg;
+    _cb = cb;
+}
+
+uint8_t ExoNaut_MotorMonitor::fault(uint8_t motor) const
+{
+    return (motor == 1 || motor == 2) ? _faults.fault(motor - 1) : MOTOR_OK;
+}
+
+float ExoNaut_MotorMonitor::trackingError(uint8_t motor) const
+{
+    return (motor == 1 || motor == 2) ? _faults.measured(motor - 1) - _faults.command(motor - 1) : 0;
+}
+
+float ExoNaut_MotorMonitor::measuredRPM(uint8_t motor) const
+{
+    return (motor == 1 || motor == 2) ? _faults.measured(motor - 1) : 0;
+}
+
+void ExoNaut_MotorMonitor::clear(uint8_t motor)
+{
+    for (int i = 0; i < 2; i++)
+    {
+        if (motor == 0 || motor == i + 1)
+        {
+            _faults.clear(i); // the next frame re-judges the wheel
+        }
+    }
+}
+
+void ExoNaut_MotorMonitor::onEncoder(const encoder_snapshot_t *snap, void *arg)
+{
+    ((ExoNaut_MotorMonitor *)arg)->check(snap);
+}
+
+void ExoNaut_MotorMonitor::report(uint8_t i)
+{
+    uint8_t fault = _faults.fault(i);
+    if (fault != MOTOR_OK && (_cutMask & MOTOR_FAULT_MASK(fault)))
+    {
+        _faults.latch(i);
+        _robot->stop_motor(i + 1);
+    }
+    motor_fault_callback_t cb = _cb;
+    if (cb != nullptr)
+    {
+        cb(i + 1, fault, _cbArg);
+    }
+}
+
+void ExoNaut_MotorMonitor::check(const encoder_snapshot_t *snap)
+{
+    // encoder_motor holds the negated command in set_motor_speed() units
+    float command[2] = {-encoder_motor.speed_1 * EXONAUT_RPM_PER_SPEED, -encoder_motor.speed_2 * EXONAUT_RPM_PER_SPEED};
+    uint8_t changed = _faults.update(snap, encoder_motor.pulse_p_r, command);
+    for (int i = 0; i < 2; i++)
+    {
+        if (changed & (1 << i))
+        {
+            report(i);
+        }
+        else if (_faults.latched(i) && command[i] != 0)
+        {
+            _robot->stop_motor(i + 1); // something drove the wheel again; hold it off until clear()
+        }
+    }
+}
@@ -0,0 +1,73 @@
+/*
+ * ExoNaut_MotorMonitor.h
+ *
+ * Date: October 16th, 2026
+ *
+ * Watches the wheels for stalls, slip and a lifted wheel by comparing each
+ * motor's commanded speed with the speed measured from the encoder stream.
+ * The check runs from an encoder listener, so it costs the sketch nothing
+ * between frames; the classifiers themselves are in ExoNaut_MotorFaults.h:
+ *
+ *   STALL  the wheel turns at less than stallRatio of its command
+ *   LIFT   the wheel turns faster than its command by more than liftRatio,
+ *          as an unloaded wheel does when the robot is picked up
+ *   SLIP   the two wheels disagree with the commanded ratio between them by
+ *          more than slipRatio; the faster wheel is flagged
+ *
+ * A condition has to last for the hold time before it is reported, and is
+ * only judged once a new command has had the settle time to take effect.
+ * Faults included in the cut mask (stalls by default) stop the motor and
+ * stay latched until clear() is called; while latched, the monitor stops the
+ * wheel again on every frame that finds it commanded.  A controller that keeps
+ * driving (VelocityControl, Motion) is not stopped by the cut, so stop it from
+ * the fault callback or the wheel will twitch at the frame rate.
+ */
+
+#ifndef EXONAUT_MOTORMONITOR_H
+#define EXONAUT_MOTORMONITOR_H
+
+#include <Arduino.h>
+#include "ExoNaut.h"
+#include "ExoNaut_MotorFaults.h"
+
+#define MOTOR_FAULT_MASK(fault) (1 << (fault))
+
+#define MONITOR_RATE_HZ 50 // encoder rate claimed while monitoring
+#define MONITOR_CUT_MASK MOTOR_FAULT_MASK(MOTOR_STALL) // faults that stop the motor by default
+
+// Called from rx_task whenever a motor's state changes; must return quickly
+typedef void (*motor_fault_callback_t)(uint8_t motor, uint8_t fault, void *arg);
+
+class ExoNaut_MotorMonitor
+{
+public:
+    ExoNaut_MotorMonitor();
+
+    bool begin(exonaut *robot, uint16_t rate_hz = MONITOR_RATE_HZ);
+    void end(void);
+
+    void setThresholds(float stall_ratio, float slip_ratio, float lift_ratio, float min_rpm = MONITOR_MIN_RPM);
+    void setTiming(uint16_t settle_ms, uint16_t hold_ms);
+    void setCutMask(uint8_t mask); // default MONITOR_CUT_MASK; 0 only reports
+    void onFault(motor_fault_callback_t cb, void *arg);
+
+    uint8_t fault(uint8_t motor) const;      // MOTOR_OK, MOTOR_STALL, MOTOR_SLIP or MOTOR_LIFT
+    float trackingError(uint8_t motor) const; // measured minus commanded, rpm
+    float measuredRPM(uint8_t motor) const;
+    void clear(uint8_t motor = 0);            // 0 clears both
+
+private:
+    static void onEncoder(const encoder_snapshot_t *snap, void *arg);
+    void check(const encoder_snapshot_t *snap);
+    void report(uint8_t i);
+
+    exonaut *_robot;
+    bool _running;
+    uint16_t _streamHz; // rate claimed from start_encoder_stream()
+    ExoNaut_MotorFaults _faults;
+    uint8_t _cutMask;
+    motor_fault_callback_t _cb;
+    void *_cbArg;
+};
+
+#endif // EXONAUT_MOTORMONITOR_H
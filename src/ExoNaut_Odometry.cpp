@@ -0,0 +1,216 @@
+/*
+ * ExoNaut_Odometry.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * Implementation of the differential drive odometry.
+ */
+
+#include "ExoNaut_Odometry.h"
+#include <math.h>
+
+#define ODOM_PI 3.14159265358979f
+
+#if EXONAUT_ODOM_FIXED_POINT
+// atan(2^-i) as a binary angle, for the CORDIC rotation
+static const int32_t cordic_atan[] = {
+    0x20000000, 0x12E4051E, 0x09FB385B, 0x051111D4, 0x028B0D43, 0x0145D7E1, 0x00A2F61E, 0x00517C55,
+    0x0028BE53, 0x00145F2F, 0x000A2F98, 0x000517CC, 0x00028BE6, 0x000145F3, 0x0000A2FA, 0x0000517D,
+    0x000028BE, 0x0000145F, 0x00000A30, 0x00000518, 0x0000028C, 0x00000146, 0x000000A3, 0x00000051,
+};
+#define CORDIC_STEPS (sizeof(cordic_atan) / sizeof(cordic_atan[0]))
+#define CORDIC_GAIN_Q30 0x26DD3B6A // 1 / prod(sqrt(1 + 2^-2i)) in Q30
+
+// Cosine and sine of a binary angle, Q30
+static void cordic_sincos(uint32_t bam, int32_t *c, int32_t *s)
+{
+    // Fold into -90..90 degrees, where CORDIC converges
+    int32_t a = (int32_t)bam;
+    bool flip = false;
+    if (a > 0x40000000 || a < -0x40000000)
+    {
+        a = (int32_t)(bam + 0x80000000u);
+        flip = true;
+    }
+    int32_t x = CORDIC_GAIN_Q30;
+    int32_t y = 0;
+    for (uint32_t i = 0; i < CORDIC_STEPS; ++i)
+    {
+        int32_t nx, ny;
+        if (a >= 0)
+        {
+            nx = x - (y >> i);
+            ny = y + (x >> i);
+            a -= cordic_atan[i];
+        }
+        else
+        {
+            nx = x + (y >> i);
+            ny = y - (x >> i);
+            a += cordic_atan[i];
+        }
+        x = nx;
+        y = ny;
+    }
+    *c = flip ? -x : x;
+    *s = flip ? -y : y;
+}
+#endif
+
+ExoNaut_Odometry::ExoNaut_Odometry() : noise(ODOM_NOISE)
+{
+    setGeometry(32.5f, 190.0f, 1120);
+    reset();
+}
+
+void ExoNaut_Odometry::setGeometry(float radius_mm, float track_mm, float pulses_per_rev)
+{
+    float mm = 2.0f * ODOM_PI * radius_mm / pulses_per_rev;
+    track = track_mm;
+#if EXONAUT_ODOM_FIXED_POINT
+    mm_per_pulse_q16 = (int32_t)lroundf(mm * 65536.0f);
+    // heading change = mm / track radians = mm / track / (2 pi) turns
+    bam_per_pulse = (int32_t)llround((double)mm / track_mm / (2.0 * ODOM_PI) * 4294967296.0);
+#else
+    mm_per_pulse = mm;
+#endif
+}
+
+void ExoNaut_Odometry::setNoise(float mm2_per_mm)
+{
+    noise = mm2_per_mm;
+}
+
+void ExoNaut_Odometry::reset(float x, float y, float heading)
+{
+    latched = false;
+    for (int i = 0; i < 6; ++i)
+    {
+        cov[i] = 0;
+    }
+    timestamp_us = 0;
+    updates = 0;
+#if EXONAUT_ODOM_FIXED_POINT
+    x_q16 = (int64_t)llroundf(x * 65536.0f);
+    y_q16 = (int64_t)llroundf(y * 65536.0f);
+    heading_bam = (uint32_t)llroundf(heading / (2.0f * ODOM_PI) * 4294967296.0f);
+#else
+    this->x = x;
+    this->y = y;
+    this->heading = heading;
+#endif
+}
+
+void ExoNaut_Odometry::update(int32_t count_1, int32_t count_2, uint32_t timestamp_us)
+{
+    this->timestamp_us = timestamp_us;
+    if (!latched)
+    {
+        last_1 = count_1;
+        last_2 = count_2;
+        latched = true;
+        return;
+    }
+    int32_t d1 = count_1 - last_1; // wraps correctly with the counts
+    int32_t d2 = count_2 - last_2;
+    last_1 = count_1;
+    last_2 = count_2;
+    ++updates;
+    if (d1 == 0 && d2 == 0)
+    {
+        return;
+    }
+
+#if EXONAUT_ODOM_FIXED_POINT
+    // Distance in Q16 mm, heading change as a binary angle
+    int64_t ds = ((int64_t)(d1 + d2) * mm_per_pulse_q16) / 2;
+    int32_t dh = (int32_t)(uint32_t)((int64_t)(d2 - d1) * bam_per_pulse); // wraps like the heading
+    uint32_t mid = heading_bam + (uint32_t)(dh / 2);
+    int32_t c, s;
+    cordic_sincos(mid, &c, &s);
+    x_q16 += (ds * c) >> 30;
+    y_q16 += (ds * s) >> 30;
+    float heading_mid = (float)(int32_t)mid * (2.0f * ODOM_PI / 4294967296.0f);
+    heading_bam += (uint32_t)dh;
+    float dl = d1 * (mm_per_pulse_q16 / 65536.0f);
+    float dr = d2 * (mm_per_pulse_q16 / 65536.0f);
+    propagate((float)ds / 65536.0f, heading_mid, dl, dr);
+#else
+    float dl = d1 * mm_per_pulse;
+    float dr = d2 * mm_per_pulse;
+    float ds = (dl + dr) * 0.5f;
+    float dh = (dr - dl) / track;
+    float mid = heading + dh * 0.5f;
+    x += ds * cosf(mid);
+    y += ds * sinf(mid);
+    heading += dh;
+    if (heading > ODOM_PI)
+    {
+        heading -= 2.0f * ODOM_PI;
+    }
+    else if (heading < -ODOM_PI)
+    {
+        heading += 2.0f * ODOM_PI;
+    }
+    propagate(ds, mid, dl, dr);
+#endif
+}
+
+// P = F P F' + G Q G', with F the Jacobian of the pose update and G that of
+// the two wheel distances
+void ExoNaut_Odometry::propagate(float ds, float heading_mid, float dl, float dr)
+{
+    float c = cosf(heading_mid);
+    float s = sinf(heading_mid);
+    float a = -ds * s; // d x / d heading
+    float b = ds * c;  // d y / d heading
+
+    float pxx = cov[0], pxy = cov[1], pxh = cov[2], pyy = cov[3], pyh = cov[4], phh = cov[5];
+    // F = [1 0 a; 0 1 b; 0 0 1]
+    float nxx = pxx + 2 * a * pxh + a * a * phh;
+    float nxy = pxy + a * pyh + b * pxh + a * b * phh;
+    float nxh = pxh + a * phh;
+    float nyy = pyy + 2 * b * pyh + b * b * phh;
+    float nyh = pyh + b * phh;
+    float nhh = phh;
+
+    // G columns for the left and right wheel distances
+    float vl = noise * fabsf(dl);
+    float vr = noise * fabsf(dr);
+    float half_ds_dh = 0.5f * ds / track; // effect of a wheel on the midpoint heading
+    float gxl = 0.5f * c + half_ds_dh * s, gxr = 0.5f * c - half_ds_dh * s;
+    float gyl = 0.5f * s - half_ds_dh * c, gyr = 0.5f * s + half_ds_dh * c;
+    float ghl = -1.0f / track, ghr = 1.0f / track;
+    nxx += gxl * gxl * vl + gxr * gxr * vr;
+    nxy += gxl * gyl * vl + gxr * gyr * vr;
+    nxh += gxl * ghl * vl + gxr * ghr * vr;
+    nyy += gyl * gyl * vl + gyr * gyr * vr;
+    nyh += gyl * ghl * vl + gyr * ghr * vr;
+    nhh += ghl * ghl * vl + ghr * ghr * vr;
+
+    cov[0] = nxx;
+    cov[1] = nxy;
+    cov[2] = nxh;
+    cov[3] = nyy;
+    cov[4] = nyh;
+    cov[5] = nhh;
+}
+
+void ExoNaut_Odometry::getPose(odom_pose_t *pose) const
+{
+#if EXONAUT_ODOM_FIXED_POINT
+    pose->x = (float)x_q16 / 65536.0f;
+    pose->y = (float)y_q16 / 65536.0f;
+    pose->heading = (float)(int32_t)heading_bam * (2.0f * ODOM_PI / 4294967296.0f);
+#else
+    pose->x = x;
+    pose->y = y;
+    pose->heading = heading;
+#endif
+    for (int i = 0; i < 6; ++i)
+    {
+        pose->cov[i] = cov[i];
+    }
+    pose->timestamp_us = timestamp_us;
+    pose->updates = updates;
+}
@@ -0,0 +1,83 @@
+/*
+ * ExoNaut_Odometry.h
+ *
+ * Date: October 16th, 2026
+ *
+ * Differential drive odometry.  Each pair of encoder counts is turned into a
+ * pose update (x, y in mm, heading in radians, counter-clockwise positive,
+ * motor 1 on the left), and the pose covariance grows with the distance each
+ * wheel travels:
+ *
+ *   var(wheel) = noise * |distance|   (mm^2 per mm)
+ *
+ * Define EXONAUT_ODOM_FIXED_POINT to 1 to integrate the pose in integer
+ * arithmetic: positions in Q16 mm, the heading as a 32 bit binary angle and
+ * sine/cosine by CORDIC.  That path gives the same result on every platform,
+ * so a recorded count sequence reproduces a pose bit for bit on a desktop.
+ * The default float path is a little faster on the ESP32's FPU.  The
+ * covariance is kept in float either way.
+ *
+ * This file has no Arduino dependencies.
+ */
+
+#ifndef EXONAUT_ODOMETRY_H
+#define EXONAUT_ODOMETRY_H
+
+#include <stdint.h>
+
+#ifndef EXONAUT_ODOM_FIXED_POINT
+#define EXONAUT_ODOM_FIXED_POINT 0
+#endif
+
+#define ODOM_NOISE 0.01f // default wheel variance in mm^2 per mm travelled
+
+typedef struct __odom_pose_t
+{
+    float x;       // mm
+    float y;       // mm
+    float heading; // radians, -pi to pi
+    float cov[6];  // upper triangle of the covariance: xx, xy, xh, yy, yh, hh
+    uint32_t timestamp_us; // time of the encoder frame behind this pose
+    uint32_t updates;
+} odom_pose_t;
+
+class ExoNaut_Odometry
+{
+public:
+    ExoNaut_Odometry();
+
+    void setGeometry(float radius_mm, float track_mm, float pulses_per_rev);
+    void setNoise(float mm2_per_mm);
+    void reset(float x = 0, float y = 0, float heading = 0); // the next update only latches the counts
+
+    // Absolute wheel counts as reported by the encoders
+    void update(int32_t count_1, int32_t count_2, uint32_t timestamp_us);
+    void getPose(odom_pose_t *pose) const;
+
+private:
+    void propagate(float ds, float heading_mid, float dl, float dr);
+
+    bool latched;
+    int32_t last_1;
+    int32_t last_2;
+    float noise;
+    float track;
+    float cov[6];
+    uint32_t timestamp_us;
+    uint32_t updates;
+
+#if EXONAUT_ODOM_FIXED_POINT
+    int64_t x_q16; // mm, Q16
+    int64_t y_q16;
+    uint32_t heading_bam; // 2^32 per turn
+    int32_t mm_per_pulse_q16;
+    int32_t bam_per_pulse; // heading change per pulse of wheel difference
+#else
+    float x;
+    float y;
+    float heading;
+    float mm_per_pulse;
+#endif
+};
+
+#endif // EXONAUT_ODOMETRY_H
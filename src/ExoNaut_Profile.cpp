@@ -0,0 +1,95 @@
+/*
+ * ExoNaut_Profile.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * Implementation of the trapezoidal and S-curve velocity profiles.
+ */
+
+#include "ExoNaut_Profile.h"
+#include <math.h>
+
+#define PROFILE_PI 3.14159265358979f
+
+ExoNaut_Profile::ExoNaut_Profile() : shape(PROFILE_TRAPEZOID), dir(1), total(0), peak(0), ramp_s(0), cruise_s(0)
+{
+}
+
+bool ExoNaut_Profile::plan(float distance, float max_speed, float max_accel, uint8_t shape)
+{
+    if (max_speed <= 0 || max_accel <= 0)
+    {
+        return false;
+    }
+    this->shape = shape;
+    dir = distance < 0 ? -1.0f : 1.0f;
+    total = fabsf(distance);
+
+    // Both shapes cover peak * ramp_s / 2 while ramping.  The cosine ramp's
+    // steepest point is pi/2 times its mean acceleration, so it ramps longer.
+    float k = shape == PROFILE_SCURVE ? PROFILE_PI / 2.0f : 1.0f;
+    peak = max_speed;
+    ramp_s = k * peak / max_accel;
+    if (peak * ramp_s > total)
+    {
+        // Triangle: total = peak * ramp_s = k * peak^2 / max_accel
+        peak = sqrtf(total * max_accel / k);
+        ramp_s = k * peak / max_accel;
+    }
+    cruise_s = peak > 0 ? (total - peak * ramp_s) / peak : 0;
+    if (cruise_s < 0)
+    {
+        cruise_s = 0;
+    }
+    return true;
+}
+
+float ExoNaut_Profile::ramp(float t, float *vel) const
+{
+    if (ramp_s <= 0)
+    {
+        *vel = peak;
+        return 0;
+    }
+    if (shape == PROFILE_SCURVE)
+    {
+        float w = PROFILE_PI / ramp_s;
+        *vel = peak * 0.5f * (1.0f - cosf(w * t));
+        return peak * 0.5f * (t - sinf(w * t) / w);
+    }
+    float a = peak / ramp_s;
+    *vel = a * t;
+    return 0.5f * a * t * t;
+}
+
+bool ExoNaut_Profile::sample(float t, float *pos, float *vel) const
+{
+    float end = duration();
+    float p, v;
+    if (t >= end)
+    {
+        *pos = dir * total;
+        *vel = 0;
+        return false;
+    }
+    if (t < 0)
+    {
+        t = 0;
+    }
+    if (t < ramp_s)
+    {
+        p = ramp(t, &v);
+    }
+    else if (t < ramp_s + cruise_s)
+    {
+        p = 0.5f * peak * ramp_s + peak * (t - ramp_s);
+        v = peak;
+    }
+    else
+    {
+        p = total - ramp(end - t, &v); // the deceleration mirrors the acceleration
+    }
+    *pos = dir * p;
+    *vel = dir * v;
+    return true;
+}
@@ -0,0 +1,49 @@
+/*
+ * ExoNaut_Profile.h
+ *
+ * Date: October 16th, 2026
+ *
+ * Rest-to-rest velocity profiles for the motion planner.  A profile covers a
+ * signed distance (mm, or degrees for a turn) without exceeding a speed and
+ * an acceleration limit.  The trapezoid ramps at a constant acceleration; the
+ * S-curve shapes each ramp as half a cosine so the acceleration also starts
+ * and ends at zero, which keeps the wheels from slipping on smooth floors.
+ * Short moves that never reach the speed limit become triangles.
+ *
+ * This file has no Arduino dependencies.
+ */
+
+#ifndef EXONAUT_PROFILE_H
+#define EXONAUT_PROFILE_H
+
+#include <stdint.h>
+
+#define PROFILE_TRAPEZOID 0
+#define PROFILE_SCURVE 1
+
+class ExoNaut_Profile
+{
+public:
+    ExoNaut_Profile();
+
+    // Returns false for limits that are not positive
+    bool plan(float distance, float max_speed, float max_accel, uint8_t shape = PROFILE_TRAPEZOID);
+
+    // Position and velocity t seconds after the start; false once t is past the end
+    bool sample(float t, float *pos, float *vel) const;
+    float duration(void) const { return 2.0f * ramp_s + cruise_s; }
+    float distance(void) const { return dir * total; }
+    float peakSpeed(void) const { return dir * peak; }
+
+private:
+    float ramp(float t, float *vel) const; // distance covered t seconds into the acceleration
+
+    uint8_t shape;
+    float dir;
+    float total;   // absolute distance
+    float peak;    // absolute cruise speed
+    float ramp_s;  // length of each ramp
+    float cruise_s;
+};
+
+#endif // EXONAUT_PROFILE_H
@@ -0,0 +1,162 @@
+/*
+ * ExoNaut_SegmentFollower.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * Implementation of the closed loop segment follower.
+ */
+
+#include "ExoNaut_SegmentFollower.h"
+#include <math.h>
+
+#define FOLLOW_PI 3.14159265358979f
+
+static float clampf(float x, float lo, float hi)
+{
+    return x < lo ? lo : (x > hi ? hi : x);
+}
+
+ExoNaut_SegmentFollower::ExoNaut_SegmentFollower() : mm_per_pulse(0), track(1), target(0), speed(0), kv(0), kw(0), heading0(0),
+                                                     tolerance(0), settle_s(0), carry_mm(0), carry_rad(0), latched(false), chained(false),
+                                                     start_1(0), start_2(0), end_1(0), end_2(0), last_t(0), heading_sum(0), done(0),
+                                                     dist_mm(0), heading(0)
+{
+}
+
+void ExoNaut_SegmentFollower::setGeometry(float radius_mm, float track_mm, float pulses_per_rev)
+{
+    mm_per_pulse = 2.0f * FOLLOW_PI * radius_mm / pulses_per_rev;
+    track = track_mm;
+}
+
+bool ExoNaut_SegmentFollower::start(float distance, float speed, float accel, uint8_t shape, float kv, float kw, float tolerance,
+                                    uint16_t settle_ms)
+{
+    if (kv == 0 && kw == 0)
+    {
+        return false;
+    }
+    // A drive or arc makes up the distance and steers out the heading error;
+    // a turn adds the heading error to its angle
+    float goal = kv != 0 ? distance + carry_mm * kv : distance + carry_rad / kw;
+    if (!profile.plan(goal, speed, accel, shape))
+    {
+        return false;
+    }
+    target = goal;
+    this->speed = speed;
+    this->kv = kv;
+    this->kw = kw;
+    heading0 = kv != 0 ? carry_rad : 0;
+    this->tolerance = tolerance;
+    settle_s = settle_ms * 0.001f;
+    latched = chained;
+    start_1 = end_1;
+    start_2 = end_2;
+    last_t = 0;
+    heading_sum = 0;
+    done = 0;
+    dist_mm = 0;
+    heading = 0;
+    return true;
+}
+
+void ExoNaut_SegmentFollower::release(void)
+{
+    chained = false;
+}
+
+void ExoNaut_SegmentFollower::dropCarry(void)
+{
+    carry_mm = 0;
+    carry_rad = 0;
+    chained = false;
+}
+
+float ExoNaut_SegmentFollower::headingError(void) const
+{
+    return heading0 + kw * done - heading;
+}
+
+uint8_t ExoNaut_SegmentFollower::update(float t, int32_t count_1, int32_t count_2, float *v_mm_s, float *w_rad_s)
+{
+    *v_mm_s = 0;
+    *w_rad_s = 0;
+    if (!latched)
+    {
+        start_1 = count_1;
+        start_2 = count_2;
+        latched = true;
+    }
+    float left = (int32_t)(count_1 - start_1) * mm_per_pulse; // wraps correctly with the counts
+    float right = (int32_t)(count_2 - start_2) * mm_per_pulse;
+    dist_mm = 0.5f * (left + right);
+    heading = (right - left) / track;
+    done = kv != 0 ? dist_mm / kv : heading / kw;
+
+    float rest = target - done;
+    float dir = target < 0 ? -1.0f : 1.0f;
+    float pos, vel;
+    bool more = profile.sample(t, &pos, &vel);
+    uint8_t state = FOLLOW_RUNNING;
+    if (dir * rest < -tolerance || (!more && dir * rest <= tolerance))
+    {
+        state = FOLLOW_DONE; // gone past counts as arriving, the excess is carried back
+    }
+    else if (t >= profile.duration() + settle_s)
+    {
+        state = FOLLOW_TIMEOUT;
+    }
+    if (state != FOLLOW_RUNNING)
+    {
+        end_1 = count_1;
+        end_2 = count_2;
+        chained = true;
+        if (state == FOLLOW_TIMEOUT)
+        {
+            // Whatever stopped the robot may still be there; making up the
+            // shortfall would send the next segment lunging at it
+            carry_mm = 0;
+            carry_rad = 0;
+        }
+        else if (kv != 0)
+        {
+            carry_mm = rest * kv;
+            carry_rad = headingError();
+        }
+        else
+        {
+            carry_mm = 0; // a distance short along the old heading is no use along the new one
+            carry_rad = rest * kw;
+        }
+        return state;
+    }
+
+    float u;
+    if (more)
+    {
+        float most = FOLLOW_CATCH_UP * speed;
+        u = clampf(vel + clampf(FOLLOW_KP * (pos - done), -most, most), -speed, speed);
+    }
+    else
+    {
+        // The profile has ended short of the target: close on it
+        u = clampf(FOLLOW_KP * fabsf(rest), FOLLOW_CREEP * speed, speed);
+        u = rest < 0 ? -u : u;
+    }
+
+    if (kv != 0)
+    {
+        float e = headingError();
+        heading_sum += e * (t - last_t);
+        *v_mm_s = u * kv;
+        *w_rad_s = u * kw + FOLLOW_KH * e + FOLLOW_KI * heading_sum;
+    }
+    else
+    {
+        *v_mm_s = -FOLLOW_KP * dist_mm; // a turn stays on the spot
+        *w_rad_s = u * kw;
+    }
+    last_t = t;
+    return FOLLOW_RUNNING;
+}
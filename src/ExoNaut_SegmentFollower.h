@@ -0,0 +1,93 @@
+/*
+ * ExoNaut_SegmentFollower.h
+ *
+ * Date: October 16th, 2026
+ *
+ * Closes a motion segment on the encoders.  ExoNaut_Motion plans each drive,
+ * turn or arc as an ExoNaut_Profile; the follower compares the profile with
+ * the distance and heading measured from the wheel counts on every tick and
+ * returns the body speed and turn rate to command:
+ *
+ *   along the segment   profile speed + kp * (profile position - measured)
+ *   across it           a drive or arc holds the heading the path implies
+ *                       (proportional and integral, as the wheels rarely
+ *                       match), a turn holds its centre where it started
+ *
+ * The segment ends on the measured distance (or heading, for a turn), not on
+ * the profile time: once the profile has run out and the robot is within the
+ * tolerance of the target, or as soon as it has gone past it.  A robot still
+ * short of the target keeps closing on it, no slower than the creep speed,
+ * until it arrives or the settle time has passed as well.
+ *
+ * What a finished segment leaves over is made up by the next one: a distance
+ * by a drive or arc straight after it, a heading error by whichever segment
+ * comes next, either steered out on the way or added to a turn.  A segment
+ * that timed out leaves nothing over; remaining() tells the caller how far
+ * short it stopped.  A segment started before release() also picks up from
+ * the counts the last one ended on, so the wheels running down between the
+ * two count towards it.  dropCarry() forgets both.
+ *
+ * Segment units follow ExoNaut_Motion: mm along the centre line with kv = 1
+ * (drives and arcs), or degrees with kv = 0 and kw = pi/180 (turns).  Counts
+ * are positive forwards, count_1 on the left wheel.  This file has no Arduino
+ * dependencies.
+ */
+
+#ifndef EXONAUT_SEGMENTFOLLOWER_H
+#define EXONAUT_SEGMENTFOLLOWER_H
+
+#include <stdint.h>
+#include "ExoNaut_Profile.h"
+
+#define FOLLOW_RUNNING 0
+#define FOLLOW_DONE 1    // within the tolerance of the target
+#define FOLLOW_TIMEOUT 2 // still short when the settle time ran out; nothing is carried over
+
+#define FOLLOW_KP 3.0f       // 1/s, position error to speed along the segment
+#define FOLLOW_KH 6.0f       // 1/s, heading error to turn rate
+#define FOLLOW_KI 6.0f       // 1/s^2, integrated heading error to turn rate
+#define FOLLOW_CREEP 0.2f    // slowest approach once the profile has ended, fraction of the speed limit
+#define FOLLOW_CATCH_UP 0.5f // largest correction to the profile speed, fraction of the speed limit
+
+class ExoNaut_SegmentFollower
+{
+public:
+    ExoNaut_SegmentFollower();
+
+    void setGeometry(float radius_mm, float track_mm, float pulses_per_rev);
+
+    // Plans distance plus what the last segment left over
+    bool start(float distance, float speed, float accel, uint8_t shape, float kv, float kw, float tolerance, uint16_t settle_ms);
+    void release(void);   // the robot may be moved before the next segment
+    void dropCarry(void); // the next segment starts clean
+
+    // t seconds into the segment; the first call latches the start counts
+    uint8_t update(float t, int32_t count_1, int32_t count_2, float *v_mm_s, float *w_rad_s);
+
+    float duration(void) const { return profile.duration(); } // of the profile alone
+    float goal(void) const { return target; }                 // distance with the carry added
+    float progress(void) const { return done; }              // measured, segment units
+    float remaining(void) const { return target - done; }
+    float headingError(void) const; // rad, where the path wants the heading minus where it is
+
+private:
+    ExoNaut_Profile profile;
+    float mm_per_pulse;
+    float track;
+
+    float target, speed, kv, kw, heading0, tolerance;
+    float settle_s;
+    float carry_mm;  // distance the last drive or arc fell short by
+    float carry_rad; // heading error left by the last segment
+    bool latched;
+    bool chained; // the next segment starts from end_1 and end_2
+    int32_t start_1, start_2;
+    int32_t end_1, end_2;
+    float last_t;
+    float heading_sum; // integrated heading error, rad s
+    float done;    // measured progress
+    float dist_mm; // measured along the centre line
+    float heading; // measured, rad
+};
+
+#endif // EXONAUT_SEGMENTFOLLOWER_H
@@ -0,0 +1,89 @@
+/*
+ * ExoNaut_SeqLock.h
+ *
+ * Date: October 16th, 2026
+ *
+ * Sequence lock for state written by one task and read by others.  The
+ * writer never waits; a reader copies the value and retries only if the
+ * writer was part way through an update, so readers always see a consistent
+ * value without taking a mutex.
+ *
+ * There are no Arduino dependencies apart from the FreeRTOS back-off used
+ * when built for the ESP32.
+ */
+
+#ifndef EXONAUT_SEQLOCK_H
+#define EXONAUT_SEQLOCK_H
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+
+#if defined(ESP_PLATFORM)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+#define EXONAUT_SEQLOCK_SPINS 64 // read attempts before a reader sleeps one tick
+
+template <typename T>
+class ExoNaut_SeqLock
+{
+public:
+    ExoNaut_SeqLock() : seq(0)
+    {
+        memset(&value, 0, sizeof(value));
+    }
+
+    // Only one task may write
+    void write(const T &v)
+    {
+        uint32_t s = seq.load(std::memory_order_relaxed);
+        seq.store(s + 1, std::memory_order_relaxed); // odd: update in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        memcpy(&value, &v, sizeof(T));
+        seq.store(s + 2, std::memory_order_release);
+    }
+
+    void read(T *out) const
+    {
+        for (uint32_t spins = 0;; ++spins)
+        {
+            if (tryRead(out))
+            {
+                return;
+            }
+#if defined(ESP_PLATFORM)
+            // A higher priority reader on the writer's core would otherwise spin forever
+            if (spins >= EXONAUT_SEQLOCK_SPINS)
+            {
+                vTaskDelay(1);
+                spins = 0;
+            }
+#endif
+        }
+    }
+
+    bool tryRead(T *out) const
+    {
+        uint32_t s1 = seq.load(std::memory_order_acquire);
+        if (s1 & 1)
+        {
+            return false;
+        }
+        memcpy(out, &value, sizeof(T));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return seq.load(std::memory_order_relaxed) == s1;
+    }
+
+    uint32_t version(void) const
+    {
+        return seq.load(std::memory_order_acquire) >> 1;
+    }
+
+private:
+    std::atomic<uint32_t> seq;
+    T value;
+};
+
+#endif // EXONAUT_SEQLOCK_H
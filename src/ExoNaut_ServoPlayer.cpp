@@ -0,0 +1,126 @@
+/*
+ * ExoNaut_ServoPlayer.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * Implementation of the bus servo trajectory player.
+ */
+
+#include "ExoNaut_ServoPlayer.h"
+
+ExoNaut_ServoPlayer::ExoNaut_ServoPlayer() : _robot(nullptr), _task(NULL), _waiter(NULL), _stopping(false), _playing(false),
+                                             _cancel(false), _trajectory(nullptr), _periodMs(1000 / SERVO_TRAJ_RATE_HZ), _elapsed(0)
+{
+}
+
+bool ExoNaut_ServoPlayer::begin(exonaut *robot)
+{
+    if (robot == nullptr || _task != NULL)
+    {
+        return false;
+    }
+    _robot = robot;
+    _stopping = false;
+    if (xTaskCreatePinnedToCore(taskEntry, "servo_play", SERVO_PLAYER_TASK_STACK, this, 2, &_task, 0) != pdPASS)
+    {
+        _task = NULL;
+        return false;
+    }
+    return true;
+}
+
+void ExoNaut_ServoPlayer::end(void)
+{
+    if (_task == NULL)
+    {
+        return;
+    }
+    _stopping = true;
+    xTaskNotifyGive(_task);
+    while (_task != NULL)
+    {
+        delay(1); // the task clears _task on its way out
+    }
+}
+
+bool ExoNaut_ServoPlayer::play(const ExoNaut_ServoTrajectory *trajectory, uint16_t rate_hz)
+{
+    if (_task == NULL || _playing || trajectory == nullptr || trajectory->keyframeCount() == 0 || rate_hz == 0)
+    {
+        return false;
+    }
+    if (rate_hz > SERVO_PLAYER_MAX_HZ)
+    {
+        rate_hz = SERVO_PLAYER_MAX_HZ; // packets would queue up behind each other in tx_task
+    }
+    _trajectory = trajectory;
+    _periodMs = 1000 / rate_hz;
+    _elapsed = 0;
+    _cancel = false;
+    _playing = true;
+    xTaskNotifyGive(_task);
+    return true;
+}
+
+void ExoNaut_ServoPlayer::stop(void)
+{
+    if (_playing)
+    {
+        _cancel = true;
+    }
+}
+
+bool ExoNaut_ServoPlayer::wait(uint32_t timeout_ms)
+{
+    uint32_t start = millis();
+    _waiter = xTaskGetCurrentTaskHandle();
+    while (_playing && (timeout_ms == 0xFFFFFFFF || millis() - start < timeout_ms))
+    {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(_periodMs)); // woken when the trajectory ends
+    }
+    _waiter = NULL;
+    return !_playing;
+}
+
+void ExoNaut_ServoPlayer::taskEntry(void *arg)
+{
+    ((ExoNaut_ServoPlayer *)arg)->run();
+}
+
+void ExoNaut_ServoPlayer::run(void)
+{
+    bus_servo_pose_t poses[BUS_SERVO_MAX_BATCH];
+    while (!_stopping)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (!_playing)
+        {
+            continue;
+        }
+
+        TickType_t begin = xTaskGetTickCount();
+        TickType_t wake = begin;
+        bool more = true;
+        while (more && !_cancel && !_stopping)
+        {
+            // Aim each packet at where the curve will be when the move ends
+            uint32_t now = (xTaskGetTickCount() - begin) * portTICK_PERIOD_MS;
+            _elapsed = now;
+            more = _trajectory->sample(now + _periodMs, poses);
+            _robot->bus_servo_set_poses(poses, _trajectory->servoCount(), _periodMs, false);
+            if (more)
+            {
+                vTaskDelayUntil(&wake, pdMS_TO_TICKS(_periodMs));
+            }
+        }
+
+        _playing = false;
+        TaskHandle_t waiter = _waiter;
+        if (waiter != NULL)
+        {
+            xTaskNotifyGive(waiter);
+        }
+    }
+    _task = NULL;
+    vTaskDelete(NULL);
+}
@@ -0,0 +1,52 @@
+/*
+ * ExoNaut_ServoPlayer.h
+ *
+ * Date: October 16th, 2026
+ *
+ * Plays an ExoNaut_ServoTrajectory on the bus servos.  A task on core 0
+ * samples the trajectory at a fixed rate and sends one batched move packet
+ * per tick, with the tick length as the move time so each servo glides to
+ * the next setpoint.  The sketch keeps running while the arm moves.
+ */
+
+#ifndef EXONAUT_SERVOPLAYER_H
+#define EXONAUT_SERVOPLAYER_H
+
+#include <Arduino.h>
+#include "ExoNaut.h"
+#include "ExoNaut_ServoTrajectory.h"
+
+#define SERVO_PLAYER_TASK_STACK 2560
+#define SERVO_PLAYER_MAX_HZ 100 // faster rates are capped; a full batch takes ~3 ms on the wire
+
+class ExoNaut_ServoPlayer
+{
+public:
+    ExoNaut_ServoPlayer();
+
+    bool begin(exonaut *robot);
+    void end(void);
+
+    // The trajectory must not change while it plays; rate_hz is capped at SERVO_PLAYER_MAX_HZ
+    bool play(const ExoNaut_ServoTrajectory *trajectory, uint16_t rate_hz = SERVO_TRAJ_RATE_HZ);
+    void stop(void); // servos hold where the last packet sent them
+    bool busy(void) const { return _playing; }
+    bool wait(uint32_t timeout_ms = 0xFFFFFFFF);
+    uint32_t position(void) const { return _elapsed; } // ms into the trajectory
+
+private:
+    static void taskEntry(void *arg);
+    void run(void);
+
+    exonaut *_robot;
+    TaskHandle_t _task;
+    volatile TaskHandle_t _waiter;
+    volatile bool _stopping;
+    volatile bool _playing;
+    volatile bool _cancel;
+    const ExoNaut_ServoTrajectory *_trajectory;
+    uint16_t _periodMs;
+    volatile uint32_t _elapsed;
+};
+
+#endif // EXONAUT_SERVOPLAYER_H
@@ -0,0 +1,123 @@
+/*
+ * ExoNaut_ServoTrajectory.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * Implementation of the bus servo keyframe interpolation.
+ */
+
+#include "ExoNaut_ServoTrajectory.h"
+#include <string.h>
+
+ExoNaut_ServoTrajectory::ExoNaut_ServoTrajectory() : servos(0), frames(0), mode(SERVO_TRAJ_MIN_JERK)
+{
+}
+
+bool ExoNaut_ServoTrajectory::setServos(const uint8_t *ids, uint8_t count)
+{
+    if (count == 0 || count > BUS_SERVO_MAX_BATCH)
+    {
+        return false;
+    }
+    memcpy(this->ids, ids, count);
+    servos = count;
+    frames = 0;
+    return true;
+}
+
+bool ExoNaut_ServoTrajectory::addKeyframe(uint32_t time_ms, const uint16_t *positions)
+{
+    if (servos == 0 || frames >= SERVO_TRAJ_MAX_KEYFRAMES || (frames > 0 && time_ms <= times[frames - 1]))
+    {
+        return false;
+    }
+    times[frames] = time_ms;
+    for (uint8_t i = 0; i < servos; ++i)
+    {
+        pos[frames][i] = positions[i] > BUS_SERVO_POS_MAX ? BUS_SERVO_POS_MAX : positions[i];
+    }
+    ++frames;
+    return true;
+}
+
+void ExoNaut_ServoTrajectory::clear(void)
+{
+    frames = 0;
+}
+
+void ExoNaut_ServoTrajectory::setInterpolation(uint8_t mode)
+{
+    this->mode = mode;
+}
+
+// Slope at a keyframe in positions per ms: zero at the ends, otherwise the
+// slope between the neighbouring keyframes (Catmull-Rom)
+float ExoNaut_ServoTrajectory::tangent(uint8_t frame, uint8_t servo) const
+{
+    if (frame == 0 || frame >= frames - 1)
+    {
+        return 0;
+    }
+    return ((float)pos[frame + 1][servo] - (float)pos[frame - 1][servo]) / (float)(times[frame + 1] - times[frame - 1]);
+}
+
+bool ExoNaut_ServoTrajectory::sample(uint32_t t_ms, bus_servo_pose_t *poses) const
+{
+    if (frames == 0)
+    {
+        return false;
+    }
+    uint8_t k = 0;
+    while (k + 1 < frames && t_ms >= times[k + 1])
+    {
+        ++k;
+    }
+    bool more = t_ms < times[frames - 1];
+    for (uint8_t i = 0; i < servos; ++i)
+    {
+        poses[i].id = ids[i];
+        if (!more || k + 1 >= frames || t_ms <= times[k])
+        {
+            // Before the first keyframe, at a keyframe or after the last one
+            poses[i].pos = pos[(!more) ? frames - 1 : k][i];
+            continue;
+        }
+        float h = (float)(times[k + 1] - times[k]);
+        float s = (float)(t_ms - times[k]) / h;
+        float p0 = pos[k][i];
+        float p1 = pos[k + 1][i];
+        float p;
+        if (mode == SERVO_TRAJ_CUBIC)
+        {
+            float s2 = s * s, s3 = s2 * s;
+            p = (2 * s3 - 3 * s2 + 1) * p0 + (s3 - 2 * s2 + s) * h * tangent(k, i) + (-2 * s3 + 3 * s2) * p1 + (s3 - s2) * h * tangent(k + 1, i);
+        }
+        else
+        {
+            float s3 = s * s * s;
+            p = p0 + (p1 - p0) * s3 * (10 - 15 * s + 6 * s * s);
+        }
+        // A spline can overshoot past the servo's travel
+        if (p < 0)
+        {
+            p = 0;
+        }
+        else if (p > BUS_SERVO_POS_MAX)
+        {
+            p = BUS_SERVO_POS_MAX;
+        }
+        poses[i].pos = (uint16_t)(p + 0.5f);
+    }
+    return more;
+}
+
+size_t ExoNaut_ServoTrajectory::packetAt(uint32_t t_ms, uint16_t move_ms, uint8_t *buf, size_t size) const
+{
+    bus_servo_pose_t poses[BUS_SERVO_MAX_BATCH];
+    if (frames == 0)
+    {
+        return 0;
+    }
+    sample(t_ms, poses);
+    return exonaut_servo_encode_move(poses, servos, move_ms, buf, size);
+}
@@ -0,0 +1,68 @@
+/*
+ * ExoNaut_ServoTrajectory.h
+ *
+ * Date: October 16th, 2026
+ *
+ * Keyframe trajectories for the bus servos.  A trajectory names up to
+ * BUS_SERVO_MAX_BATCH servos and holds a list of keyframes, each a time and
+ * one position per servo.  Between keyframes the positions follow either a
+ * minimum jerk curve, which comes to rest at every keyframe, or a cubic
+ * spline that passes through the inner keyframes without stopping.
+ *
+ * This file has no Arduino dependencies, so the packet timeline a trajectory
+ * produces can be checked on a desktop.  ExoNaut_ServoPlayer (see
+ * ExoNaut_ServoPlayer.h) streams a trajectory to the servos from a task:
+ *
+ *   uint8_t ids[] = {1, 2};
+ *   uint16_t open[] = {200, 500}, lift[] = {450, 300};
+ *   arm.setServos(ids, 2);
+ *   arm.addKeyframe(0, open);
+ *   arm.addKeyframe(800, lift);
+ *   player.begin(&robot);
+ *   player.play(&arm);
+ */
+
+#ifndef EXONAUT_SERVOTRAJECTORY_H
+#define EXONAUT_SERVOTRAJECTORY_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "ExoNaut_BusServo.h"
+
+#define SERVO_TRAJ_MAX_KEYFRAMES 16
+#define SERVO_TRAJ_RATE_HZ 50 // default packet rate of the player
+
+#define SERVO_TRAJ_MIN_JERK 0
+#define SERVO_TRAJ_CUBIC 1
+
+class ExoNaut_ServoTrajectory
+{
+public:
+    ExoNaut_ServoTrajectory();
+
+    bool setServos(const uint8_t *ids, uint8_t count); // also clears the keyframes
+    bool addKeyframe(uint32_t time_ms, const uint16_t *positions); // times must increase
+    void clear(void);                                   // keyframes only
+    void setInterpolation(uint8_t mode);
+
+    uint8_t servoCount(void) const { return servos; }
+    uint8_t keyframeCount(void) const { return frames; }
+    uint32_t duration(void) const { return frames ? times[frames - 1] : 0; }
+
+    // Positions t_ms after the start, one per servo; false once past the end
+    bool sample(uint32_t t_ms, bus_servo_pose_t *poses) const;
+    // The move packet a player sends at t_ms, with move_ms as the servo move time
+    size_t packetAt(uint32_t t_ms, uint16_t move_ms, uint8_t *buf, size_t size) const;
+
+private:
+    float tangent(uint8_t frame, uint8_t servo) const;
+
+    uint8_t ids[BUS_SERVO_MAX_BATCH];
+    uint8_t servos;
+    uint8_t frames;
+    uint8_t mode;
+    uint32_t times[SERVO_TRAJ_MAX_KEYFRAMES];
+    uint16_t pos[SERVO_TRAJ_MAX_KEYFRAMES][BUS_SERVO_MAX_BATCH];
+};
+
+#endif // EXONAUT_SERVOTRAJECTORY_H
@@ -0,0 +1,249 @@
+/*
+ * ExoNaut_Telemetry.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * Implementation of the co-processor telemetry decoder.
+ */
+
+#include "ExoNaut_Telemetry.h"
+#include "ExoNaut_Capture.h"
+#include "ExoNaut_Commands.h"
+#include "ExoNaut_Hex.h"
+#include <math.h>
+#include <string.h>
+
+#define TELEM_VOLT_SCALE 51.765f // mV per unit of the 'A' frame voltage byte
+#define TELEM_BYTE_PER_SPEED (90.0f / 55.0f / 60.0f * 6.8f) // speed byte per unit of set_motor_speed()
+#define TELEM_SEQ_BACKSTEP 16 // a binary 'E' sequence this far behind the last one is a repeat or a late frame
+
+static inline int32_t rd_le32(const uint8_t *p)
+{
+    return (int32_t)((uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24));
+}
+
+static inline int32_t rd_be32(const uint8_t *p)
+{
+    return (int32_t)(((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3]);
+}
+
+ExoNaut_Telemetry::ExoNaut_Telemetry()
+{
+    reset();
+}
+
+void ExoNaut_Telemetry::reset(void)
+{
+    memset(&state, 0, sizeof(state));
+    state.volt = -1;
+    state.battery = battery.status();
+    ir_event_count = 0;
+    memset(&servo, 0, sizeof(servo));
+    version[0] = '\0';
+    frame_errors = 0;
+    encoder_seq = 0;
+    encoder_seq_valid = false;
+}
+
+uint8_t ExoNaut_Telemetry::decode(const exonaut_frame_t *frame, uint32_t now_us, uint32_t now_ms, float load)
+{
+    ir_event_count = 0;
+    if (frame->len == 0)
+    {
+        return 0;
+    }
+    if (frame->format == EXONAUT_FRAME_BINARY)
+    {
+        return decodeBinary(frame->data, frame->len, now_us, now_ms, load);
+    }
+    return decodeAscii(frame->data, frame->len, now_us, now_ms, load);
+}
+
+// Battery and IR status, carried by 'A' frames in either format
+uint8_t ExoNaut_Telemetry::applyStatus(uint8_t volt_raw, uint16_t ir_code, uint32_t now_ms, float load)
+{
+    uint8_t flags = TELEM_STATUS;
+    if (battery.update((float)volt_raw * TELEM_VOLT_SCALE, load, now_ms))
+    {
+        flags |= TELEM_BATTERY_LEVEL;
+    }
+    state.volt = battery.status().volt;
+    state.battery = battery.status();
+    state.ir_key = ir_code;
+    ir_event_count = ir.update(ir_code, now_ms, ir_events);
+    if (ir_event_count > 0)
+    {
+        flags |= TELEM_IR_EVENTS;
+    }
+    return flags;
+}
+
+// Raw co-processor counts; the robot counts the opposite way
+uint8_t ExoNaut_Telemetry::applyEncoder(int32_t tol_1, int32_t tol_2, uint32_t now_us)
+{
+    state.encoder.count_1 = -tol_1;
+    state.encoder.count_2 = -tol_2;
+    state.encoder.timestamp_us = now_us;
+    ++state.encoder.seq;
+    return TELEM_ENCODER;
+}
+
+uint8_t ExoNaut_Telemetry::applyVersion(const uint8_t *ver, uint8_t len)
+{
+    if (len > TELEM_VERSION_MAX)
+    {
+        len = TELEM_VERSION_MAX;
+    }
+    memcpy(version, ver, len);
+    version[len] = '\0';
+    return TELEM_VERSION;
+}
+
+// cmd is not null terminated; len excludes the '$'
+uint8_t ExoNaut_Telemetry::decodeAscii(const uint8_t *cmd, uint8_t len, uint32_t now_us, uint32_t now_ms, float load)
+{
+    switch (cmd[0])
+    {
+    case 'A':
+        if (len == 7)
+        { // "A<volt hex2><ir low hex2><ir high hex2>$"
+            uint8_t a[3];
+            if (!exonaut_hex_decode(cmd + 1, 6, a))
+            {
+                ++frame_errors;
+                return TELEM_ERROR;
+            }
+            return applyStatus(a[0], ((uint16_t)a[2] << 8) | a[1], now_ms, load);
+        }
+        if (len == 3)
+        { // Assuming this means "OK$" or similar short ack
+            return TELEM_ACK;
+        }
+        break;
+    case 'V':
+        if (len == 4)
+        { // e.g., "V123$"; the co-processor (re)started and talks ASCII
+            encoder_seq_valid = false;
+            return applyVersion(cmd, len);
+        }
+        break;
+    case 'S':
+    { // "S<id><pos lo><pos hi><volt lo><volt hi><temp>$", each byte as hex2
+        if (len != 1 + 2 * BUS_SERVO_STATUS_LEN)
+        {
+            break;
+        }
+        if (!exonaut_servo_decode_status(cmd, len, EXONAUT_FRAME_ASCII, &servo))
+        {
+            ++frame_errors;
+            return TELEM_ERROR;
+        }
+        return TELEM_SERVO;
+    }
+    case 'E':
+        if (len == 19 && cmd[1] == 'M' && cmd[2] == 'M')
+        { // Example "EMM<16 hex chars>$" -> 3+16 = 19, two big-endian int32 counts, motor 2 first
+            // The hex digits are cmd[3..18].  Before the ring buffer framer the loop
+            // added a further 2 to each index and read past the end of the frame.
+            uint8_t e[8];
+            if (!exonaut_hex_decode(cmd + 3, 16, e))
+            {
+                ++frame_errors;
+                ++state.encoder.dropped;
+                return TELEM_ERROR;
+            }
+            return applyEncoder(rd_be32(e + 4), rd_be32(e), now_us);
+        }
+        break;
+    default:
+        break;
+    }
+    return 0;
+}
+
+// body[0] is the frame type and len counts the type byte plus the payload.
+// Payload layouts are in ExoNaut.h.
+uint8_t ExoNaut_Telemetry::decodeBinary(const uint8_t *body, uint8_t len, uint32_t now_us, uint32_t now_ms, float load)
+{
+    const uint8_t *pl = body + 1;
+    uint8_t pl_len = len - 1;
+    switch (body[0])
+    {
+    case 'A':
+        if (pl_len == 3)
+        {
+            return applyStatus(pl[0], ((uint16_t)pl[2] << 8) | pl[1], now_ms, load);
+        }
+        if (pl_len == 0)
+        {
+            return TELEM_ACK;
+        }
+        break;
+    case 'E':
+        if (pl_len == 9)
+        {
+            // pl[0] is the co-processor's frame sequence; a gap means frames were lost on the wire
+            if (encoder_seq_valid)
+            {
+                uint8_t step = (uint8_t)(pl[0] - encoder_seq);
+                if (step == 0 || (uint8_t)(encoder_seq - pl[0]) <= TELEM_SEQ_BACKSTEP)
+                {
+                    return 0; // its counts are no newer than the ones held
+                }
+                state.encoder.dropped += step - 1;
+            }
+            encoder_seq = pl[0];
+            encoder_seq_valid = true;
+            return applyEncoder(rd_le32(pl + 1), rd_le32(pl + 5), now_us);
+        }
+        break;
+    case 'V':
+        // Sent after a restart or to confirm the switch to binary; either way the 'E' sequence starts over
+        encoder_seq_valid = false;
+        return applyVersion(pl, pl_len);
+    case 'S':
+        if (exonaut_servo_decode_status(body, len, EXONAUT_FRAME_BINARY, &servo))
+        {
+            return TELEM_SERVO;
+        }
+        break;
+    default:
+        break;
+    }
+    return 0;
+}
+
+typedef struct
+{
+    ExoNaut_Telemetry *telem;
+    exonaut_telemetry_callback_t cb;
+    void *arg;
+    float load;
+} replay_ctx_t;
+
+static void replay_tx(const exonaut_capture_record_t *rec, void *arg)
+{
+    replay_ctx_t *ctx = (replay_ctx_t *)arg;
+    // Speed packet {0x55, 0x55, 0x05, 55, 0x02, byte_1, byte_2}
+    if (rec->len == EXONAUT_SPEED_PACKET_SIZE && rec->data[0] == 0x55 && rec->data[1] == 0x55 && rec->data[3] == EXONAUT_MOTOR_CMD &&
+        rec->data[4] == EXONAUT_SUB_SPEED)
+    {
+        ctx->load = (fabsf((float)(int8_t)rec->data[5]) + fabsf((float)(int8_t)rec->data[6])) * 0.5f / TELEM_BYTE_PER_SPEED;
+    }
+}
+
+static void replay_frame(const exonaut_frame_t *frame, uint32_t time_us, void *arg)
+{
+    replay_ctx_t *ctx = (replay_ctx_t *)arg;
+    uint8_t flags = ctx->telem->decode(frame, time_us, time_us / 1000, ctx->load);
+    if (ctx->cb != NULL)
+    {
+        ctx->cb(flags, ctx->telem, time_us, ctx->arg);
+    }
+}
+
+uint32_t exonaut_telemetry_replay(const uint8_t *data, size_t len, ExoNaut_Telemetry *telem, exonaut_telemetry_callback_t cb, void *arg)
+{
+    replay_ctx_t ctx = {telem, cb, arg, 0};
+    return exonaut_capture_replay(data, len, replay_frame, &ctx, replay_tx);
+}
@@ -0,0 +1,95 @@
+/*
+ * ExoNaut_Telemetry.h
+ *
+ * Date: October 16th, 2026
+ *
+ * Decoding of the co-processor's telemetry.  ExoNaut_Telemetry turns each
+ * frame from ExoNaut_Framer into state: encoder counts, battery and IR status,
+ * acks, bus servo replies and the firmware version.  rx_task runs every frame
+ * through it and then publishes the result and calls the sketch's callbacks;
+ * exonaut_telemetry_replay() runs a capture (ExoNaut_Capture.h) through the
+ * same decoder, so a recorded decoding problem can be reproduced off the robot.
+ *
+ * This file has no Arduino dependencies so the decoder can be fed recorded
+ * byte streams on a desktop machine.
+ */
+
+#ifndef EXONAUT_TELEMETRY_H
+#define EXONAUT_TELEMETRY_H
+
+#include <stdint.h>
+#include "ExoNaut_Battery.h"
+#include "ExoNaut_BusServo.h"
+#include "ExoNaut_Framer.h"
+#include "ExoNaut_IREvents.h"
+
+// One decoded 'EMM' / binary 'E' frame.  Counts are absolute (count_base is not
+// applied) so deltas between snapshots stay valid across reset_encoder_counter().
+typedef struct __encoder_snapshot_t
+{
+    int32_t count_1;
+    int32_t count_2;
+    uint32_t timestamp_us; // micros() when the frame was read from the UART
+    uint32_t seq;          // increments by one for every encoder frame received
+    uint32_t dropped;      // encoder frames rejected or missing from the co-processor sequence; repeats are skipped, not counted
+} encoder_snapshot_t;
+
+// Everything the co-processor reports, published by rx_task as one consistent unit
+typedef struct __coproc_state_t
+{
+    encoder_snapshot_t encoder;
+    float volt;      // filtered battery voltage in mV, -1 until the first 'A' frame
+    uint16_t ir_key; // IR code currently held down, 0 when none
+    battery_status_t battery;
+} coproc_state_t;
+
+// ExoNaut_Telemetry::decode() result flags
+#define TELEM_ENCODER 0x01       // new counts in state.encoder
+#define TELEM_STATUS 0x02        // new battery voltage and IR key
+#define TELEM_BATTERY_LEVEL 0x04 // state.battery.level changed
+#define TELEM_IR_EVENTS 0x08     // ir_events holds ir_event_count events
+#define TELEM_ACK 0x10           // action-finished reply
+#define TELEM_SERVO 0x20         // new reading in servo
+#define TELEM_VERSION 0x40       // new text in version
+#define TELEM_ERROR 0x80         // frame rejected, counted in frame_errors
+
+#define TELEM_VERSION_MAX 7 // longest version text kept
+
+class ExoNaut_Telemetry
+{
+public:
+    ExoNaut_Telemetry();
+
+    void reset(void);
+    // load is the mean absolute commanded wheel speed, for the battery sag fit
+    uint8_t decode(const exonaut_frame_t *frame, uint32_t now_us, uint32_t now_ms, float load);
+
+    coproc_state_t state;
+    ExoNaut_Battery battery;
+    ExoNaut_IREvents ir;
+    ir_event_t ir_events[IR_MAX_EVENTS];
+    uint8_t ir_event_count;
+    bus_servo_reading_t servo;
+    char version[TELEM_VERSION_MAX + 1];
+    uint32_t frame_errors; // frames rejected for non-hex payload characters
+
+private:
+    uint8_t decodeAscii(const uint8_t *cmd, uint8_t len, uint32_t now_us, uint32_t now_ms, float load);
+    uint8_t decodeBinary(const uint8_t *body, uint8_t len, uint32_t now_us, uint32_t now_ms, float load);
+    uint8_t applyStatus(uint8_t volt_raw, uint16_t ir_code, uint32_t now_ms, float load);
+    uint8_t applyEncoder(int32_t tol_1, int32_t tol_2, uint32_t now_us);
+    uint8_t applyVersion(const uint8_t *ver, uint8_t len);
+
+    uint8_t encoder_seq; // last sequence byte seen in a binary 'E' frame
+    bool encoder_seq_valid;
+};
+
+// Called by exonaut_telemetry_replay() after every decoded frame
+typedef void (*exonaut_telemetry_callback_t)(uint8_t flags, const ExoNaut_Telemetry *telem, uint32_t time_us, void *arg);
+
+// Runs the received bytes of a capture through a framer and telem, the same way
+// rx_task does.  The battery load is taken from the speed packets the capture
+// recorded going out.  Returns the number of frames decoded.
+uint32_t exonaut_telemetry_replay(const uint8_t *data, size_t len, ExoNaut_Telemetry *telem, exonaut_telemetry_callback_t cb, void *arg);
+
+#endif // EXONAUT_TELEMETRY_H
@@ -0,0 +1,251 @@
+/*
+ * ExoNaut_VelocityControl.cpp
+ *
+ * Date: October 16th, 2026
+ *
+ * Implementation of the closed loop wheel speed controller.
+ */
+
+#include "ExoNaut_VelocityControl.h"
+
+ExoNaut_VelocityControl::ExoNaut_VelocityControl() : _robot(nullptr), _task(NULL), _stopping(false), _streamHz(0),
+                                                     _kp(VELOCITY_KP), _ki(VELOCITY_KI), _kd(VELOCITY_KD), _idle(true)
+{
+    _mux = portMUX_INITIALIZER_UNLOCKED;
+    for (int i = 0; i < 2; i++)
+    {
+        _target[i] = 0;
+        _measured[i] = 0;
+        _integral[i] = 0;
+        _lastError[i] = 0;
+    }
+}
+
+bool ExoNaut_VelocityControl::begin(exonaut *robot, uint16_t rate_hz)
+{
+    if (robot == nullptr || _task != NULL)
+    {
+        return false;
+    }
+    _robot = robot;
+    _stopping = false;
+    _idle = true;
+    if (xTaskCreatePinnedToCore(taskEntry, "vel_ctrl", VELOCITY_TASK_STACK, this, 2, &_task, 0) != pdPASS)
+    {
+        _task = NULL;
+        return false;
+    }
+    if (!_robot->add_encoder_listener(onEncoder, this) || !_robot->start_encoder_stream(rate_hz))
+    {
+        end();
+        return false;
+    }
+    _streamHz = rate_hz;
+    return true;
+}
+
+void ExoNaut_VelocityControl::end(void)
+{
+    if (_task == NULL)
+    {
+        return;
+    }
+    _robot->remove_encoder_listener(onEncoder, this);
+    if (_streamHz != 0)
+    {
+        _robot->stop_encoder_stream(_streamHz); // other users keep their stream
+        _streamHz = 0;
+    }
+    _stopping = true;
+    xTaskNotifyGive(_task);
+    while (_task != NULL)
+    {
+        delay(1); // the task clears _task on its way out
+    }
+    _robot->stop_motor(0);
+}
+
+void ExoNaut_VelocityControl::setGains(float kp, float ki, float kd)
+{
+    portENTER_CRITICAL(&_mux);
+    _kp = kp;
+    _ki = ki;
+    _kd = kd;
+    portEXIT_CRITICAL(&_mux);
+}
+
+void ExoNaut_VelocityControl::setRPM(float rpm1, float rpm2)
+{
+    portENTER_CRITICAL(&_mux);
+    _target[0] = rpm1;
+    _target[1] = rpm2;
+    portEXIT_CRITICAL(&_mux);
+}
+
+void ExoNaut_VelocityControl::setSpeed(float mm_s1, float mm_s2)
+{
+    setRPM(speedToRpm(mm_s1), speedToRpm(mm_s2));
+}
+
+void ExoNaut_VelocityControl::setTwist(float mm_s, float deg_s)
+{
+    float track;
+    _robot->get_wheel_geometry(NULL, &track);
+    float diff = deg_s * (PI / 180.0f) * track * 0.5f;
+    setSpeed(mm_s - diff, mm_s + diff);
+}
+
+void ExoNaut_VelocityControl::stop(void)
+{
+    portENTER_CRITICAL(&_mux);
+    _target[0] = 0;
+    _target[1] = 0;
+    portEXIT_CRITICAL(&_mux);
+}
+
+float ExoNaut_VelocityControl::getRPM(uint8_t motor)
+{
+    return (motor == 1 || motor == 2) ? _measured[motor - 1] : 0;
+}
+
+float ExoNaut_VelocityControl::getSpeed(uint8_t motor)
+{
+    return rpmToSpeed(getRPM(motor));
+}
+
+float ExoNaut_VelocityControl::getTargetRPM(uint8_t motor)
+{
+    return (motor == 1 || motor == 2) ? _target[motor - 1] : 0;
+}
+
+float ExoNaut_VelocityControl::rpmToSpeed(float rpm)
+{
+    float radius;
+    _robot->get_wheel_geometry(&radius, NULL);
+    return rpm * (2.0f * PI * radius / 60.0f);
+}
+
+float ExoNaut_VelocityControl::speedToRpm(float mm_s)
+{
+    float radius;
+    _robot->get_wheel_geometry(&radius, NULL);
+    return mm_s * (60.0f / (2.0f * PI * radius));
+}
+
+void ExoNaut_VelocityControl::onEncoder(const encoder_snapshot_t *snap, void *arg)
+{
+    // rx_task context: just wake the control task
+    xTaskNotifyGive(((ExoNaut_VelocityControl *)arg)->_task);
+}
+
+void ExoNaut_VelocityControl::taskEntry(void *arg)
+{
+    ((ExoNaut_VelocityControl *)arg)->run();
+}
+
+void ExoNaut_VelocityControl::run(void)
+{
+    encoder_snapshot_t prev;
+    encoder_snapshot_t frames[4];
+    bool have_prev = false;
+    _robot->get_encoder_snapshot(&prev);
+    uint32_t seq = prev.seq;
+
+    while (!_stopping)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        uint8_t n;
+        while ((n = _robot->read_encoder_history(seq, frames, 4)) > 0)
+        {
+            for (uint8_t i = 0; i < n; i++)
+            {
+                if (have_prev && frames[i].seq == prev.seq + 1)
+                {
+                    control(&prev, &frames[i]);
+                }
+                prev = frames[i];
+                have_prev = true;
+            }
+            seq = prev.seq;
+        }
+    }
+
+    _task = NULL;
+    vTaskDelete(NULL);
+}
+
+void ExoNaut_VelocityControl::control(const encoder_snapshot_t *prev, const encoder_snapshot_t *now)
+{
+    uint32_t dt_us = now->timestamp_us - prev->timestamp_us;
+    if (dt_us == 0)
+    {
+        return;
+    }
+    float dt = dt_us * 1e-6f;
+    float ppr = encoder_motor.pulse_p_r;
+    float rpm[2];
+    rpm[0] = (float)(now->count_1 - prev->count_1) / ppr / dt * 60.0f;
+    rpm[1] = (float)(now->count_2 - prev->count_2) / ppr / dt * 60.0f;
+
+    float target[2], kp, ki, kd;
+    bool reset = false;
+    portENTER_CRITICAL(&_mux);
+    target[0] = _target[0];
+    target[1] = _target[1];
+    kp = _kp;
+    ki = _ki;
+    kd = _kd;
+    portEXIT_CRITICAL(&_mux);
+
+    for (int i = 0; i < 2; i++)
+    {
+        _measured[i] += (rpm[i] - _measured[i]) * VELOCITY_FILTER;
+    }
+    if (target[0] == 0 && target[1] == 0)
+    {
+        // Hold the motors stopped rather than servoing around zero
+        if (!_idle)
+        {
+            _robot->stop_motor(0);
+            _idle = true;
+        }
+        _integral[0] = _integral[1] = 0;
+        return;
+    }
+    if (_idle)
+    {
+        reset = true;
+        _idle = false;
+    }
+
+    float out[2];
+    for (int i = 0; i < 2; i++)
+    {
+        float error = target[i] - _measured[i];
+        if (reset)
+        {
+            _integral[i] = 0;
+            _lastError[i] = error;
+        }
+        float derivative = (error - _lastError[i]) / dt;
+        _lastError[i] = error;
+
+        // Feed forward the open loop conversion; the PI terms only trim it
+        float u = target[i] / EXONAUT_RPM_PER_SPEED + kp * error + ki * (_integral[i] + error * dt) + kd * derivative;
+        if (u > VELOCITY_OUTPUT_MAX)
+        {
+            u = VELOCITY_OUTPUT_MAX;
+        }
+        else if (u < -VELOCITY_OUTPUT_MAX)
+        {
+            u = -VELOCITY_OUTPUT_MAX;
+        }
+        else
+        {
+            _integral[i] += error * dt; // only integrate while unsaturated
+        }
+        out[i] = u;
+    }
+
+    _robot->set_motor_speed(out[0], out[1]);
+}
@@ -0,0 +1,79 @@
+/*
+ * ExoNaut_VelocityControl.h
+ *
+ * Date: October 16th, 2026
+ *
+ * Closed loop wheel speed control for the ExoNaut.  set_motor_speed() sends a
+ * fixed conversion of the requested speed to the co-processor and the actual
+ * wheel speed then drifts with battery voltage and load.  This class streams
+ * the encoder counts, measures each wheel's speed and runs a PI loop per
+ * wheel in a task on core 0, so targets can be given in real units:
+ *
+ *   ExoNaut_VelocityControl drive;
+ *   drive.begin(&robot);      // after robot.begin()
+ *   drive.setSpeed(150, 150); // both wheels at 150 mm/s
+ *
+ * The loop runs once per encoder frame.  The controller owns the motors while
+ * it is running; call end() before going back to set_motor_speed().
+ */
+
+#ifndef EXONAUT_VELOCITYCONTROL_H
+#define EXONAUT_VELOCITYCONTROL_H
+
+#include <Arduino.h>
+#include "ExoNaut.h"
+
+#define VELOCITY_RATE_HZ 50      // default encoder stream and control rate
+#define VELOCITY_KP 0.4f         // default speed units per rpm of error
+#define VELOCITY_KI 3.0f         // default speed units per rpm second of error
+#define VELOCITY_KD 0.0f
+#define VELOCITY_OUTPUT_MAX 100.0f // largest command sent to set_motor_speed()
+#define VELOCITY_FILTER 0.5f     // weight of the newest speed measurement
+#define VELOCITY_TASK_STACK 2560
+
+class ExoNaut_VelocityControl
+{
+public:
+    ExoNaut_VelocityControl();
+
+    // Starts the encoder stream and the control task
+    bool begin(exonaut *robot, uint16_t rate_hz = VELOCITY_RATE_HZ);
+    void end(void); // stops the motors and the control task
+
+    void setGains(float kp, float ki, float kd = VELOCITY_KD);
+
+    // Targets, motor 1 first.  Positive values drive the robot forwards.
+    void setRPM(float rpm1, float rpm2);
+    void setSpeed(float mm_s1, float mm_s2);
+    void setTwist(float mm_s, float deg_s); // body speed and turn rate, positive deg_s turns left
+    void stop(void);                        // targets to zero, the motors are held stopped
+
+    // Measured wheel speeds
+    float getRPM(uint8_t motor);
+    float getSpeed(uint8_t motor); // mm/s
+    float getTargetRPM(uint8_t motor);
+    bool running(void) const { return _task != NULL; }
+
+private:
+    static void taskEntry(void *arg);
+    static void onEncoder(const encoder_snapshot_t *snap, void *arg);
+    void run(void);
+    void control(const encoder_snapshot_t *prev, const encoder_snapshot_t *now);
+    float rpmToSpeed(float rpm);
+    float speedToRpm(float mm_s);
+
+    exonaut *_robot;
+    TaskHandle_t _task;
+    volatile bool _stopping;
+    uint16_t _streamHz; // rate claimed from start_encoder_stream(), 0 if none
+    portMUX_TYPE _mux;
+
+    float _kp, _ki, _kd;
+    float _target[2];   // rpm
+    float _measured[2]; // rpm, filtered
+    float _integral[2];
+    float _lastError[2];
+    bool _idle;         // both targets zero and the motors stopped
+};
+
+#endif // EXONAUT_VELOCITYCONTROL_H